@@ -0,0 +1,111 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/base/CMakeLists.txt"
+  "/root/repo/examples/CMakeLists.txt"
+  "/root/repo/net/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tools/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "base/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "net/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "base/CMakeFiles/base_lib.dir/DependInfo.cmake"
+  "net/CMakeFiles/net_lib.dir/DependInfo.cmake"
+  "examples/CMakeFiles/echoserver.dir/DependInfo.cmake"
+  "examples/CMakeFiles/test_qps.dir/DependInfo.cmake"
+  "examples/CMakeFiles/hot_restart_server.dir/DependInfo.cmake"
+  "test/CMakeFiles/benchmark_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/timer_benchmark.dir/DependInfo.cmake"
+  "test/CMakeFiles/log_benchmark.dir/DependInfo.cmake"
+  "test/CMakeFiles/log_contention_benchmark.dir/DependInfo.cmake"
+  "test/CMakeFiles/binlog_benchmark.dir/DependInfo.cmake"
+  "test/CMakeFiles/log_level_benchmark.dir/DependInfo.cmake"
+  "test/CMakeFiles/threadpool_benchmark.dir/DependInfo.cmake"
+  "test/CMakeFiles/threadpool_priority_benchmark.dir/DependInfo.cmake"
+  "tools/CMakeFiles/binlog_decode.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_logger.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_lockqueue.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_thread.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_threadpool.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_eventloop_v1.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_eventloop_v2.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_acceptor.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_timer.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_client.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_log_level.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_idle_timeout.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_tcp_stats.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_auto_cork.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_cross_thread_send.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_timer_heap.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_timer_slack.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_mono_time.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_async_logging.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_log_stream.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_log_rings.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_log_file.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_binary_log.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_log_module_level.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_log_overflow.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_work_stealing_pool.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_lockqueue_batch.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_compute_offload.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_elastic_threadpool.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_priority_threadpool.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_unique_function.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_strand.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_hot_restart.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/base/AsyncLogging.cpp" "base/CMakeFiles/base_lib.dir/AsyncLogging.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/AsyncLogging.cpp.o.d"
+  "/root/repo/base/BinaryLog.cpp" "base/CMakeFiles/base_lib.dir/BinaryLog.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/BinaryLog.cpp.o.d"
+  "/root/repo/base/CurrentThread.cpp" "base/CMakeFiles/base_lib.dir/CurrentThread.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/CurrentThread.cpp.o.d"
+  "/root/repo/base/LogFile.cpp" "base/CMakeFiles/base_lib.dir/LogFile.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/LogFile.cpp.o.d"
+  "/root/repo/base/Logger.cpp" "base/CMakeFiles/base_lib.dir/Logger.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/Logger.cpp.o.d"
+  "/root/repo/base/MonoTime.cpp" "base/CMakeFiles/base_lib.dir/MonoTime.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/MonoTime.cpp.o.d"
+  "/root/repo/base/Strand.cpp" "base/CMakeFiles/base_lib.dir/Strand.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/Strand.cpp.o.d"
+  "/root/repo/base/Thread.cpp" "base/CMakeFiles/base_lib.dir/Thread.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/Thread.cpp.o.d"
+  "/root/repo/base/ThreadPool.cpp" "base/CMakeFiles/base_lib.dir/ThreadPool.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/ThreadPool.cpp.o.d"
+  "/root/repo/base/Timestamp.cpp" "base/CMakeFiles/base_lib.dir/Timestamp.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/Timestamp.cpp.o.d"
+  "/root/repo/base/WorkStealingPool.cpp" "base/CMakeFiles/base_lib.dir/WorkStealingPool.cpp.o" "gcc" "base/CMakeFiles/base_lib.dir/WorkStealingPool.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,31 @@
+file(REMOVE_RECURSE
+  "/root/repo/lib/libbase_lib.a"
+  "/root/repo/lib/libbase_lib.pdb"
+  "CMakeFiles/base_lib.dir/AsyncLogging.cpp.o"
+  "CMakeFiles/base_lib.dir/AsyncLogging.cpp.o.d"
+  "CMakeFiles/base_lib.dir/BinaryLog.cpp.o"
+  "CMakeFiles/base_lib.dir/BinaryLog.cpp.o.d"
+  "CMakeFiles/base_lib.dir/CurrentThread.cpp.o"
+  "CMakeFiles/base_lib.dir/CurrentThread.cpp.o.d"
+  "CMakeFiles/base_lib.dir/LogFile.cpp.o"
+  "CMakeFiles/base_lib.dir/LogFile.cpp.o.d"
+  "CMakeFiles/base_lib.dir/Logger.cpp.o"
+  "CMakeFiles/base_lib.dir/Logger.cpp.o.d"
+  "CMakeFiles/base_lib.dir/MonoTime.cpp.o"
+  "CMakeFiles/base_lib.dir/MonoTime.cpp.o.d"
+  "CMakeFiles/base_lib.dir/Strand.cpp.o"
+  "CMakeFiles/base_lib.dir/Strand.cpp.o.d"
+  "CMakeFiles/base_lib.dir/Thread.cpp.o"
+  "CMakeFiles/base_lib.dir/Thread.cpp.o.d"
+  "CMakeFiles/base_lib.dir/ThreadPool.cpp.o"
+  "CMakeFiles/base_lib.dir/ThreadPool.cpp.o.d"
+  "CMakeFiles/base_lib.dir/Timestamp.cpp.o"
+  "CMakeFiles/base_lib.dir/Timestamp.cpp.o.d"
+  "CMakeFiles/base_lib.dir/WorkStealingPool.cpp.o"
+  "CMakeFiles/base_lib.dir/WorkStealingPool.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/base_lib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
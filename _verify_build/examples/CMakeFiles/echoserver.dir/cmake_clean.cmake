@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/echoserver.dir/echoserver.cpp.o"
+  "CMakeFiles/echoserver.dir/echoserver.cpp.o.d"
+  "echoserver"
+  "echoserver.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/echoserver.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
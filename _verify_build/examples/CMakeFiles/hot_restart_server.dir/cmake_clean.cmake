@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hot_restart_server.dir/hot_restart_server.cpp.o"
+  "CMakeFiles/hot_restart_server.dir/hot_restart_server.cpp.o.d"
+  "hot_restart_server"
+  "hot_restart_server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hot_restart_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_qps.dir/test_qps.cpp.o"
+  "CMakeFiles/test_qps.dir/test_qps.cpp.o.d"
+  "test_qps"
+  "test_qps.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_qps.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,39 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/net/Acceptor.cpp" "net/CMakeFiles/net_lib.dir/Acceptor.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/Acceptor.cpp.o.d"
+  "/root/repo/net/Buffer.cpp" "net/CMakeFiles/net_lib.dir/Buffer.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/Buffer.cpp.o.d"
+  "/root/repo/net/Channel.cpp" "net/CMakeFiles/net_lib.dir/Channel.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/Channel.cpp.o.d"
+  "/root/repo/net/Connector.cpp" "net/CMakeFiles/net_lib.dir/Connector.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/Connector.cpp.o.d"
+  "/root/repo/net/CrossThreadSendQueue.cpp" "net/CMakeFiles/net_lib.dir/CrossThreadSendQueue.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/CrossThreadSendQueue.cpp.o.d"
+  "/root/repo/net/EpollPoller.cpp" "net/CMakeFiles/net_lib.dir/EpollPoller.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/EpollPoller.cpp.o.d"
+  "/root/repo/net/EventLoop.cpp" "net/CMakeFiles/net_lib.dir/EventLoop.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/EventLoop.cpp.o.d"
+  "/root/repo/net/EventLoopThread.cpp" "net/CMakeFiles/net_lib.dir/EventLoopThread.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/EventLoopThread.cpp.o.d"
+  "/root/repo/net/EventLoopThreadPool.cpp" "net/CMakeFiles/net_lib.dir/EventLoopThreadPool.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/EventLoopThreadPool.cpp.o.d"
+  "/root/repo/net/HotRestart.cpp" "net/CMakeFiles/net_lib.dir/HotRestart.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/HotRestart.cpp.o.d"
+  "/root/repo/net/InetAddress.cpp" "net/CMakeFiles/net_lib.dir/InetAddress.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/InetAddress.cpp.o.d"
+  "/root/repo/net/Poller.cpp" "net/CMakeFiles/net_lib.dir/Poller.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/Poller.cpp.o.d"
+  "/root/repo/net/Socket.cpp" "net/CMakeFiles/net_lib.dir/Socket.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/Socket.cpp.o.d"
+  "/root/repo/net/TcpClient.cpp" "net/CMakeFiles/net_lib.dir/TcpClient.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/TcpClient.cpp.o.d"
+  "/root/repo/net/TcpConnection.cpp" "net/CMakeFiles/net_lib.dir/TcpConnection.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/TcpConnection.cpp.o.d"
+  "/root/repo/net/TcpServer.cpp" "net/CMakeFiles/net_lib.dir/TcpServer.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/TcpServer.cpp.o.d"
+  "/root/repo/net/TcpStats.cpp" "net/CMakeFiles/net_lib.dir/TcpStats.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/TcpStats.cpp.o.d"
+  "/root/repo/net/Timer.cpp" "net/CMakeFiles/net_lib.dir/Timer.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/Timer.cpp.o.d"
+  "/root/repo/net/TimerQueue.cpp" "net/CMakeFiles/net_lib.dir/TimerQueue.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/TimerQueue.cpp.o.d"
+  "/root/repo/net/TimingWheel.cpp" "net/CMakeFiles/net_lib.dir/TimingWheel.cpp.o" "gcc" "net/CMakeFiles/net_lib.dir/TimingWheel.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_verify_build/base/CMakeFiles/base_lib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,49 @@
+file(REMOVE_RECURSE
+  "/root/repo/lib/libnet_lib.a"
+  "/root/repo/lib/libnet_lib.pdb"
+  "CMakeFiles/net_lib.dir/Acceptor.cpp.o"
+  "CMakeFiles/net_lib.dir/Acceptor.cpp.o.d"
+  "CMakeFiles/net_lib.dir/Buffer.cpp.o"
+  "CMakeFiles/net_lib.dir/Buffer.cpp.o.d"
+  "CMakeFiles/net_lib.dir/Channel.cpp.o"
+  "CMakeFiles/net_lib.dir/Channel.cpp.o.d"
+  "CMakeFiles/net_lib.dir/Connector.cpp.o"
+  "CMakeFiles/net_lib.dir/Connector.cpp.o.d"
+  "CMakeFiles/net_lib.dir/CrossThreadSendQueue.cpp.o"
+  "CMakeFiles/net_lib.dir/CrossThreadSendQueue.cpp.o.d"
+  "CMakeFiles/net_lib.dir/EpollPoller.cpp.o"
+  "CMakeFiles/net_lib.dir/EpollPoller.cpp.o.d"
+  "CMakeFiles/net_lib.dir/EventLoop.cpp.o"
+  "CMakeFiles/net_lib.dir/EventLoop.cpp.o.d"
+  "CMakeFiles/net_lib.dir/EventLoopThread.cpp.o"
+  "CMakeFiles/net_lib.dir/EventLoopThread.cpp.o.d"
+  "CMakeFiles/net_lib.dir/EventLoopThreadPool.cpp.o"
+  "CMakeFiles/net_lib.dir/EventLoopThreadPool.cpp.o.d"
+  "CMakeFiles/net_lib.dir/HotRestart.cpp.o"
+  "CMakeFiles/net_lib.dir/HotRestart.cpp.o.d"
+  "CMakeFiles/net_lib.dir/InetAddress.cpp.o"
+  "CMakeFiles/net_lib.dir/InetAddress.cpp.o.d"
+  "CMakeFiles/net_lib.dir/Poller.cpp.o"
+  "CMakeFiles/net_lib.dir/Poller.cpp.o.d"
+  "CMakeFiles/net_lib.dir/Socket.cpp.o"
+  "CMakeFiles/net_lib.dir/Socket.cpp.o.d"
+  "CMakeFiles/net_lib.dir/TcpClient.cpp.o"
+  "CMakeFiles/net_lib.dir/TcpClient.cpp.o.d"
+  "CMakeFiles/net_lib.dir/TcpConnection.cpp.o"
+  "CMakeFiles/net_lib.dir/TcpConnection.cpp.o.d"
+  "CMakeFiles/net_lib.dir/TcpServer.cpp.o"
+  "CMakeFiles/net_lib.dir/TcpServer.cpp.o.d"
+  "CMakeFiles/net_lib.dir/TcpStats.cpp.o"
+  "CMakeFiles/net_lib.dir/TcpStats.cpp.o.d"
+  "CMakeFiles/net_lib.dir/Timer.cpp.o"
+  "CMakeFiles/net_lib.dir/Timer.cpp.o.d"
+  "CMakeFiles/net_lib.dir/TimerQueue.cpp.o"
+  "CMakeFiles/net_lib.dir/TimerQueue.cpp.o.d"
+  "CMakeFiles/net_lib.dir/TimingWheel.cpp.o"
+  "CMakeFiles/net_lib.dir/TimingWheel.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/net_lib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/benchmark_test"
+  "../bin/benchmark_test.pdb"
+  "CMakeFiles/benchmark_test.dir/benchmark_test.cpp.o"
+  "CMakeFiles/benchmark_test.dir/benchmark_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/binlog_benchmark"
+  "../bin/binlog_benchmark.pdb"
+  "CMakeFiles/binlog_benchmark.dir/binlog_benchmark.cpp.o"
+  "CMakeFiles/binlog_benchmark.dir/binlog_benchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/binlog_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/log_benchmark"
+  "../bin/log_benchmark.pdb"
+  "CMakeFiles/log_benchmark.dir/log_benchmark.cpp.o"
+  "CMakeFiles/log_benchmark.dir/log_benchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/log_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
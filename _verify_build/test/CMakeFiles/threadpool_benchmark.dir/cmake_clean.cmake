@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/threadpool_benchmark"
+  "../bin/threadpool_benchmark.pdb"
+  "CMakeFiles/threadpool_benchmark.dir/threadpool_benchmark.cpp.o"
+  "CMakeFiles/threadpool_benchmark.dir/threadpool_benchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/threadpool_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
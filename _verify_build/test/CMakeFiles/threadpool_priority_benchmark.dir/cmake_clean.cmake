@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/threadpool_priority_benchmark"
+  "../bin/threadpool_priority_benchmark.pdb"
+  "CMakeFiles/threadpool_priority_benchmark.dir/threadpool_priority_benchmark.cpp.o"
+  "CMakeFiles/threadpool_priority_benchmark.dir/threadpool_priority_benchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/threadpool_priority_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/timer_benchmark"
+  "../bin/timer_benchmark.pdb"
+  "CMakeFiles/timer_benchmark.dir/timer_benchmark.cpp.o"
+  "CMakeFiles/timer_benchmark.dir/timer_benchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/timer_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
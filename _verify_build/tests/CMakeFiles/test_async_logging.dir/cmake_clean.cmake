@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_async_logging.dir/test_async_logging.cpp.o"
+  "CMakeFiles/test_async_logging.dir/test_async_logging.cpp.o.d"
+  "test_async_logging"
+  "test_async_logging.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_async_logging.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_auto_cork.dir/test_auto_cork.cpp.o"
+  "CMakeFiles/test_auto_cork.dir/test_auto_cork.cpp.o.d"
+  "test_auto_cork"
+  "test_auto_cork.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_auto_cork.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
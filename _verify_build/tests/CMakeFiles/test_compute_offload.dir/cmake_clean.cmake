@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_compute_offload.dir/test_compute_offload.cpp.o"
+  "CMakeFiles/test_compute_offload.dir/test_compute_offload.cpp.o.d"
+  "test_compute_offload"
+  "test_compute_offload.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_compute_offload.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_cross_thread_send.dir/test_cross_thread_send.cpp.o"
+  "CMakeFiles/test_cross_thread_send.dir/test_cross_thread_send.cpp.o.d"
+  "test_cross_thread_send"
+  "test_cross_thread_send.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_cross_thread_send.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_elastic_threadpool.dir/test_elastic_threadpool.cpp.o"
+  "CMakeFiles/test_elastic_threadpool.dir/test_elastic_threadpool.cpp.o.d"
+  "test_elastic_threadpool"
+  "test_elastic_threadpool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_elastic_threadpool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_eventloop_v1.dir/test_eventloop_v1.cpp.o"
+  "CMakeFiles/test_eventloop_v1.dir/test_eventloop_v1.cpp.o.d"
+  "test_eventloop_v1"
+  "test_eventloop_v1.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_eventloop_v1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_hot_restart.dir/test_hot_restart.cpp.o"
+  "CMakeFiles/test_hot_restart.dir/test_hot_restart.cpp.o.d"
+  "test_hot_restart"
+  "test_hot_restart.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_hot_restart.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_idle_timeout.dir/test_idle_timeout.cpp.o"
+  "CMakeFiles/test_idle_timeout.dir/test_idle_timeout.cpp.o.d"
+  "test_idle_timeout"
+  "test_idle_timeout.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_idle_timeout.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
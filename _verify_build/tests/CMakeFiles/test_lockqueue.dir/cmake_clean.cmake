@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_lockqueue.dir/test_lockqueue.cpp.o"
+  "CMakeFiles/test_lockqueue.dir/test_lockqueue.cpp.o.d"
+  "test_lockqueue"
+  "test_lockqueue.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_lockqueue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
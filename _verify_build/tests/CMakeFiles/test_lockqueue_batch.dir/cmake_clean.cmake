@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_lockqueue_batch.dir/test_lockqueue_batch.cpp.o"
+  "CMakeFiles/test_lockqueue_batch.dir/test_lockqueue_batch.cpp.o.d"
+  "test_lockqueue_batch"
+  "test_lockqueue_batch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_lockqueue_batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
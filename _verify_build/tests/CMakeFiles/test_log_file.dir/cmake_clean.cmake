@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_log_file.dir/test_log_file.cpp.o"
+  "CMakeFiles/test_log_file.dir/test_log_file.cpp.o.d"
+  "test_log_file"
+  "test_log_file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_log_file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_log_level.dir/test_log_level.cpp.o"
+  "CMakeFiles/test_log_level.dir/test_log_level.cpp.o.d"
+  "test_log_level"
+  "test_log_level.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_log_level.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_log_module_level.dir/test_log_module_level.cpp.o"
+  "CMakeFiles/test_log_module_level.dir/test_log_module_level.cpp.o.d"
+  "test_log_module_level"
+  "test_log_module_level.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_log_module_level.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
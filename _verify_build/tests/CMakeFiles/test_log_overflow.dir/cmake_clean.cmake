@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_log_overflow.dir/test_log_overflow.cpp.o"
+  "CMakeFiles/test_log_overflow.dir/test_log_overflow.cpp.o.d"
+  "test_log_overflow"
+  "test_log_overflow.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_log_overflow.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
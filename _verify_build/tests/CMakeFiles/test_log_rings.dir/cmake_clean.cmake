@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_log_rings.dir/test_log_rings.cpp.o"
+  "CMakeFiles/test_log_rings.dir/test_log_rings.cpp.o.d"
+  "test_log_rings"
+  "test_log_rings.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_log_rings.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_log_stream.dir/test_log_stream.cpp.o"
+  "CMakeFiles/test_log_stream.dir/test_log_stream.cpp.o.d"
+  "test_log_stream"
+  "test_log_stream.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_log_stream.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
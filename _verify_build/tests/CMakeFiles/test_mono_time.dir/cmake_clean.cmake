@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mono_time.dir/test_mono_time.cpp.o"
+  "CMakeFiles/test_mono_time.dir/test_mono_time.cpp.o.d"
+  "test_mono_time"
+  "test_mono_time.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mono_time.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
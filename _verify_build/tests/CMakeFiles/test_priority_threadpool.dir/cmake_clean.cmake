@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_priority_threadpool.dir/test_priority_threadpool.cpp.o"
+  "CMakeFiles/test_priority_threadpool.dir/test_priority_threadpool.cpp.o.d"
+  "test_priority_threadpool"
+  "test_priority_threadpool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_priority_threadpool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_strand.dir/test_strand.cpp.o"
+  "CMakeFiles/test_strand.dir/test_strand.cpp.o.d"
+  "test_strand"
+  "test_strand.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_strand.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
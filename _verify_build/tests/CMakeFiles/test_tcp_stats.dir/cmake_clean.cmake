@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_tcp_stats.dir/test_tcp_stats.cpp.o"
+  "CMakeFiles/test_tcp_stats.dir/test_tcp_stats.cpp.o.d"
+  "test_tcp_stats"
+  "test_tcp_stats.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tcp_stats.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_thread.dir/test_thread.cpp.o"
+  "CMakeFiles/test_thread.dir/test_thread.cpp.o.d"
+  "test_thread"
+  "test_thread.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_thread.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_timer_slack.dir/test_timer_slack.cpp.o"
+  "CMakeFiles/test_timer_slack.dir/test_timer_slack.cpp.o.d"
+  "test_timer_slack"
+  "test_timer_slack.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_timer_slack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_unique_function.dir/test_unique_function.cpp.o"
+  "CMakeFiles/test_unique_function.dir/test_unique_function.cpp.o.d"
+  "test_unique_function"
+  "test_unique_function.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_unique_function.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/binlog_decode"
+  "../bin/binlog_decode.pdb"
+  "CMakeFiles/binlog_decode.dir/binlog_decode.cpp.o"
+  "CMakeFiles/binlog_decode.dir/binlog_decode.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/binlog_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
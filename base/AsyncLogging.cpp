@@ -0,0 +1,160 @@
+// base/AsyncLogging.cpp
+
+#include "AsyncLogging.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace
+{
+
+LogFile::Options noRolling()
+{
+    LogFile::Options options;
+    options.rollSize = 0;
+    options.rollInterval = 0;
+    return options;
+}
+
+} // namespace
+
+AsyncLogging::AsyncLogging(const std::string& filename, int flushInterval)
+    : AsyncLogging(filename, noRolling(), flushInterval)
+{}
+
+AsyncLogging::AsyncLogging(const std::string& basename, const LogFile::Options& options, int flushInterval)
+    : m_filename(basename),
+      m_fileOptions(options),
+      m_flushInterval(flushInterval),
+      m_running(false),
+      m_currentBuffer(new Buffer),
+      m_nextBuffer(new Buffer)
+{
+    m_buffers.reserve(16);
+}
+
+AsyncLogging::~AsyncLogging()
+{
+    if (m_running)
+    {
+        stop();
+    }
+}
+
+void AsyncLogging::append(const char* logline, size_t len)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (static_cast<size_t>(m_currentBuffer->avail()) > len)
+    {
+        m_currentBuffer->append(logline, len);
+        return;
+    }
+
+    // 当前缓冲区满了：交给后端，换上备用缓冲区 (备用的也用掉了才分配新的)
+    m_buffers.push_back(std::move(m_currentBuffer));
+    if (m_nextBuffer)
+    {
+        m_currentBuffer = std::move(m_nextBuffer);
+    }
+    else
+    {
+        m_currentBuffer.reset(new Buffer);
+    }
+    m_currentBuffer->append(logline, len);
+    m_cond.notify_one();
+}
+
+void AsyncLogging::start()
+{
+    m_running = true;
+    m_thread = std::thread(&AsyncLogging::threadFunc, this);
+}
+
+void AsyncLogging::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+        m_cond.notify_one();
+    }
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void AsyncLogging::threadFunc()
+{
+    // 打开失败时 LogFile 自己报错到 stderr 并丢弃写入，前端照常交换缓冲区，不会因此堆积
+    LogFile output(m_filename, m_fileOptions);
+
+    // 后端自己也准备两块缓冲区，交换时直接还给前端，稳态下不再分配内存
+    BufferPtr newBuffer1(new Buffer);
+    BufferPtr newBuffer2(new Buffer);
+    BufferVector buffersToWrite;
+    buffersToWrite.reserve(16);
+
+    bool running = true;
+    while (running)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_buffers.empty() && m_running)
+            {
+                // 没有写满的缓冲区时最多等 flushInterval 秒，保证日志按时落盘
+                m_cond.wait_for(lock, std::chrono::seconds(m_flushInterval));
+            }
+            // stop() 之后再把剩下的写完一轮就退出
+            running = m_running;
+            m_buffers.push_back(std::move(m_currentBuffer));
+            m_currentBuffer = std::move(newBuffer1);
+            buffersToWrite.swap(m_buffers);
+            if (!m_nextBuffer)
+            {
+                m_nextBuffer = std::move(newBuffer2);
+            }
+        }
+
+        if (buffersToWrite.size() > kMaxBuffersToWrite)
+        {
+            char buf[256];
+            snprintf(buf, sizeof buf, "Dropped %zu log buffers (%zu bytes each), backend is too slow\n",
+                     buffersToWrite.size() - 2, sizeof(Buffer));
+            fputs(buf, stderr);
+            output.append(buf, strlen(buf));
+            buffersToWrite.resize(2);
+        }
+
+        for (const BufferPtr& buffer : buffersToWrite)
+        {
+            if (buffer->length() > 0)
+            {
+                output.append(buffer->data(), buffer->length());
+            }
+        }
+
+        // 留两块给下一轮用，其余释放
+        if (buffersToWrite.size() > 2)
+        {
+            buffersToWrite.resize(2);
+        }
+        if (!newBuffer1)
+        {
+            newBuffer1 = std::move(buffersToWrite.back());
+            buffersToWrite.pop_back();
+            newBuffer1->reset();
+        }
+        if (!newBuffer2)
+        {
+            newBuffer2 = std::move(buffersToWrite.back());
+            buffersToWrite.pop_back();
+            newBuffer2->reset();
+        }
+        buffersToWrite.clear();
+        // 空闲时也要按时换文件，而不是等到下一条日志
+        output.rollIfNeeded(::time(nullptr));
+        output.flush();
+    }
+}
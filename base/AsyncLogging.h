@@ -0,0 +1,71 @@
+// base/AsyncLogging.h
+
+#ifndef ASYNCLOGGING_H
+#define ASYNCLOGGING_H
+
+#include "noncopyable.h"
+#include "LogBuffer.h"
+#include "LogFile.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 双缓冲异步日志后端，把日志批量写入文件。
+ * - 前端线程 append 时只在锁内做一次 memcpy，拷进预先分配好的 4MB 缓冲区；
+ * - 缓冲区写满时换上备用缓冲区并通知后端，否则后端每 flushInterval 秒醒来一次；
+ * - 后端在锁内只交换缓冲区指针，出锁后每个缓冲区一次 fwrite，最后 fflush 一次。
+ * 后端来不及写时最多保留 kMaxBuffersToWrite 个缓冲区，多出的直接丢弃并在文件中注明，避免内存无限增长。
+ * 【新增】文件由后端线程持有的 LogFile 写入，滚动、fdatasync 都在后端完成，前端线程永远不会被换文件阻塞。
+ *
+ * 用法：
+ *   AsyncLogging log("server.log");
+ *   log.start();
+ *   Logger::getInstance().setOutput(
+ *       [&log](const char* msg, size_t len) { log.append(msg, len); },
+ *       [&log]() { log.stop(); });
+ */
+class AsyncLogging : noncopyable
+{
+public:
+    // 不滚动，一直追加写入 filename
+    explicit AsyncLogging(const std::string& filename, int flushInterval = 3);
+    // 【新增】按 options 滚动写入 basename.YYYYmmdd-HHMMSS.uuuuuu.pid.log
+    AsyncLogging(const std::string& basename, const LogFile::Options& options, int flushInterval = 3);
+    ~AsyncLogging();
+
+    // 前端线程调用，线程安全
+    void append(const char* logline, size_t len);
+
+    void start();
+    // 写完已经 append 的全部日志后返回；之后的 append 不再写入文件
+    void stop();
+
+private:
+    using Buffer = FixedBuffer<kLargeBuffer>;
+    using BufferPtr = std::unique_ptr<Buffer>;
+    using BufferVector = std::vector<BufferPtr>;
+
+    static const size_t kMaxBuffersToWrite = 25;
+
+    void threadFunc();
+
+    const std::string m_filename;
+    const LogFile::Options m_fileOptions;
+    const int m_flushInterval;
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    BufferPtr m_currentBuffer; // 前端正在写的缓冲区
+    BufferPtr m_nextBuffer;    // 备用缓冲区
+    BufferVector m_buffers;    // 已写满、等待后端写入的缓冲区
+};
+
+#endif
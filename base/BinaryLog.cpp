@@ -0,0 +1,557 @@
+// base/BinaryLog.cpp
+
+#include "BinaryLog.h"
+#include "LogRing.h"
+#include "Timestamp.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <ctime>
+
+namespace
+{
+
+// 与 Logger 相同：线程退出时关闭自己的环，写线程取空后把它移出列表
+struct BinaryRingHolder
+{
+    std::shared_ptr<LogRing> ring;
+
+    ~BinaryRingHolder()
+    {
+        if (ring)
+        {
+            ring->close();
+        }
+    }
+};
+
+thread_local BinaryRingHolder t_binaryRingHolder;
+
+const int kWriterIdleWaitMs = 100;
+const int kFlushTimeoutMs = 1000;
+const char* const kDefaultFile = "mymuduo.binlog";
+
+// 记录头：site id + MonoTime 纳秒
+const size_t kRecordHeaderSize = sizeof(uint32_t) + sizeof(int64_t);
+
+template<typename T>
+void appendRaw(std::string& out, T value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+} // namespace
+
+// === BinaryLogger ===
+BinaryLogger& BinaryLogger::getInstance()
+{
+    static BinaryLogger logger;
+    return logger;
+}
+
+BinaryLogger::BinaryLogger()
+    : m_filename(kDefaultFile),
+      m_fp(nullptr),
+      m_sitesWritten(0),
+      m_writerSleeping(false),
+      m_exiting(false)
+{
+    m_writerThread = std::thread(&BinaryLogger::writerThreadFunc, this);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    m_exiting.store(true);
+    wakeWriter();
+    if (m_writerThread.joinable())
+    {
+        m_writerThread.join();
+    }
+}
+
+void BinaryLogger::setFile(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_filename = filename;
+    if (m_fp != nullptr)
+    {
+        // 已经打开的文件到此为止，下一批写进新文件 (字典从头再写一遍)
+        ::fclose(m_fp);
+        m_fp = nullptr;
+    }
+}
+
+uint32_t BinaryLogger::registerSite(LogSite& site)
+{
+    std::lock_guard<std::mutex> lock(m_sitesMutex);
+    uint32_t id = site.id.load(std::memory_order_relaxed);
+    if (id == 0)
+    {
+        m_sites.push_back(&site);
+        id = static_cast<uint32_t>(m_sites.size());
+        site.id.store(id, std::memory_order_relaxed);
+    }
+    return id;
+}
+
+LogRing* BinaryLogger::threadRing()
+{
+    if (!t_binaryRingHolder.ring)
+    {
+        t_binaryRingHolder.ring = std::make_shared<LogRing>(kThreadRingSize);
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        m_rings.push_back(t_binaryRingHolder.ring);
+    }
+    return t_binaryRingHolder.ring.get();
+}
+
+void BinaryLogger::append(const char* record, size_t len)
+{
+    LogRing* ring = threadRing();
+    if (!ring->TryWrite(record, len))
+    {
+        // 与 Logger::appendToRing 相同：叫醒写线程，按 Logger 的溢出策略限时等待或直接丢弃
+        wakeWriter();
+        Logger& logger = Logger::getInstance();
+        bool written = false;
+        if (logger.overflowPolicy() == Logger::OverflowPolicy::kBlock)
+        {
+            std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::now() + std::chrono::milliseconds(logger.blockTimeoutMs());
+            while (!(written = ring->TryWrite(record, len)) && std::chrono::steady_clock::now() < deadline)
+            {
+                wakeWriter();
+                std::this_thread::yield();
+            }
+        }
+        if (!written)
+        {
+            logger.countDropped();
+            return;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerSleeping.load(std::memory_order_relaxed))
+    {
+        wakeWriter();
+    }
+}
+
+void BinaryLogger::wakeWriter()
+{
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wakeCond.notify_one();
+}
+
+bool BinaryLogger::ringsEmpty()
+{
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    for (const auto& ring : m_rings)
+    {
+        if (!ring->empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t BinaryLogger::drainRings()
+{
+    size_t count = 0;
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    for (auto it = m_rings.begin(); it != m_rings.end();)
+    {
+        bool closed = (*it)->closed();
+        count += (*it)->Consume([this](const char* record, size_t len) {
+            m_batch.push_back(static_cast<char>(binlog::kRecordEntry));
+            appendRaw(m_batch, static_cast<uint32_t>(len));
+            m_batch.append(record, len);
+        });
+        if (closed)
+        {
+            it = m_rings.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return count;
+}
+
+void BinaryLogger::writeBatch()
+{
+    if (m_fp == nullptr)
+    {
+        m_fp = ::fopen(m_filename.c_str(), "we");
+        if (m_fp == nullptr)
+        {
+            fprintf(stderr, "BinaryLogger: cannot open %s\n", m_filename.c_str());
+            m_batch.clear();
+            return;
+        }
+        std::string header(binlog::kMagic, sizeof binlog::kMagic);
+        appendRaw(header, Timestamp::now().microSecondsSinceEpoch());
+        appendRaw(header, MonoTime::now().nanoSeconds());
+        ::fwrite(header.data(), 1, header.size(), m_fp);
+        m_sitesWritten = 0;
+    }
+
+    // 取环之后再看字典：取到的记录引用的 LogSite 一定已经注册
+    std::string dictionary;
+    {
+        std::lock_guard<std::mutex> lock(m_sitesMutex);
+        for (; m_sitesWritten < m_sites.size(); ++m_sitesWritten)
+        {
+            const LogSite* site = m_sites[m_sitesWritten];
+            dictionary.push_back(static_cast<char>(binlog::kSiteEntry));
+            appendRaw(dictionary, static_cast<uint32_t>(m_sitesWritten + 1));
+            appendRaw(dictionary, static_cast<int32_t>(site->line));
+            appendRaw(dictionary, static_cast<uint8_t>(site->level));
+            appendRaw(dictionary, static_cast<uint16_t>(site->file.size()));
+            dictionary.append(site->file.data(), site->file.size());
+        }
+    }
+    ::fwrite(dictionary.data(), 1, dictionary.size(), m_fp);
+    ::fwrite(m_batch.data(), 1, m_batch.size(), m_fp);
+    ::fflush(m_fp);
+    m_batch.clear();
+}
+
+void BinaryLogger::writerThreadFunc()
+{
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            if (drainRings() > 0)
+            {
+                writeBatch();
+                continue;
+            }
+        }
+        if (m_exiting.load())
+        {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_writerSleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ringsEmpty() && !m_exiting.load())
+        {
+            m_wakeCond.wait_for(lock, std::chrono::milliseconds(kWriterIdleWaitMs));
+        }
+        m_writerSleeping.store(false);
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    if (drainRings() > 0)
+    {
+        writeBatch();
+    }
+    if (m_fp != nullptr)
+    {
+        ::fclose(m_fp);
+        m_fp = nullptr;
+    }
+}
+
+void BinaryLogger::flush()
+{
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(kFlushTimeoutMs);
+    while (!ringsEmpty() && std::chrono::steady_clock::now() < deadline)
+    {
+        wakeWriter();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    // 环空了之后写线程可能还在写最后一批：取环和写文件在同一把锁里，拿到锁就说明写完了
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+}
+
+// === BinaryLogStream ===
+BinaryLogStream::BinaryLogStream(LogSite& site)
+    : m_level(site.level)
+{
+    uint32_t id = site.id.load(std::memory_order_relaxed);
+    if (id == 0)
+    {
+        id = BinaryLogger::getInstance().registerSite(site);
+    }
+    int64_t now = MonoTime::now().nanoSeconds();
+    char* p = m_buffer.current();
+    memcpy(p, &id, sizeof id);
+    memcpy(p + sizeof id, &now, sizeof now);
+    m_buffer.add(kRecordHeaderSize);
+}
+
+BinaryLogStream::~BinaryLogStream()
+{
+    BinaryLogger::getInstance().append(m_buffer.data(), m_buffer.length());
+    if (m_level == FATAL)
+    {
+        BinaryLogger::getInstance().flush();
+        abort();
+    }
+}
+
+BinaryLogStream& BinaryLogStream::putString(const char* str, size_t len)
+{
+    const size_t header = 1 + sizeof(uint32_t);
+    if (static_cast<size_t>(m_buffer.avail()) <= header)
+    {
+        return *this;
+    }
+    // 与 LogStream 一样截断到剩余空间
+    len = std::min(len, static_cast<size_t>(m_buffer.avail()) - header - 1);
+    char* p = m_buffer.current();
+    p[0] = static_cast<char>(binlog::ArgType::kString);
+    uint32_t len32 = static_cast<uint32_t>(len);
+    memcpy(p + 1, &len32, sizeof len32);
+    memcpy(p + header, str, len);
+    m_buffer.add(header + len);
+    return *this;
+}
+
+// === 离线解码 ===
+namespace binlog
+{
+
+namespace
+{
+
+struct Site
+{
+    std::string file;
+    int line;
+    LogLevel level;
+};
+
+template<typename T>
+bool readRaw(FILE* in, T* value)
+{
+    return ::fread(value, sizeof(T), 1, in) == 1;
+}
+
+template<typename T>
+bool takeRaw(const char*& p, const char* end, T* value)
+{
+    if (static_cast<size_t>(end - p) < sizeof(T))
+    {
+        return false;
+    }
+    memcpy(value, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+template<typename T>
+void appendNumber(std::string& out, T value, int base = 10)
+{
+    char buf[32];
+    std::to_chars_result result = std::to_chars(buf, buf + sizeof buf, value, base);
+    out.append(buf, result.ptr - buf);
+}
+
+const char* levelName(LogLevel level)
+{
+    switch (level)
+    {
+    case INFO:  return "[INFO]";
+    case ERROR: return "[ERROR]";
+    case FATAL: return "[FATAL]";
+    case DEBUG: return "[DEBUG]";
+    }
+    return "[?]";
+}
+
+// 与 LogStream::formatTime 相同的 "YYYY-MM-DD HH:MM:SS.uuuuuu "
+void appendTime(std::string& out, int64_t microSecondsSinceEpoch)
+{
+    time_t seconds = static_cast<time_t>(microSecondsSinceEpoch / Timestamp::kMicroSecondsPerSecond);
+    int micros = static_cast<int>(microSecondsSinceEpoch % Timestamp::kMicroSecondsPerSecond);
+    tm tm_time;
+    localtime_r(&seconds, &tm_time);
+    char buf[64];
+    int len = snprintf(buf, sizeof buf, "%04d-%02d-%02d %02d:%02d:%02d.%06d ",
+                       tm_time.tm_year + 1900, tm_time.tm_mon + 1, tm_time.tm_mday,
+                       tm_time.tm_hour, tm_time.tm_min, tm_time.tm_sec, micros);
+    out.append(buf, len);
+}
+
+// 按 LogStream 的规则格式化参数
+bool appendArgs(std::string& out, const char* p, const char* end)
+{
+    while (p < end)
+    {
+        ArgType type = static_cast<ArgType>(*p++);
+        switch (type)
+        {
+        case ArgType::kBool:
+        {
+            uint8_t v;
+            if (!takeRaw(p, end, &v)) return false;
+            out.push_back(v ? '1' : '0');
+            break;
+        }
+        case ArgType::kInt32:
+        {
+            int32_t v;
+            if (!takeRaw(p, end, &v)) return false;
+            appendNumber(out, v);
+            break;
+        }
+        case ArgType::kUInt32:
+        {
+            uint32_t v;
+            if (!takeRaw(p, end, &v)) return false;
+            appendNumber(out, v);
+            break;
+        }
+        case ArgType::kInt64:
+        {
+            int64_t v;
+            if (!takeRaw(p, end, &v)) return false;
+            appendNumber(out, v);
+            break;
+        }
+        case ArgType::kUInt64:
+        {
+            uint64_t v;
+            if (!takeRaw(p, end, &v)) return false;
+            appendNumber(out, v);
+            break;
+        }
+        case ArgType::kDouble:
+        {
+            double v;
+            if (!takeRaw(p, end, &v)) return false;
+            char buf[48];
+            std::to_chars_result result =
+                std::to_chars(buf, buf + sizeof buf, v, std::chars_format::general, 6);
+            out.append(buf, result.ptr - buf);
+            break;
+        }
+        case ArgType::kChar:
+        {
+            char v;
+            if (!takeRaw(p, end, &v)) return false;
+            out.push_back(v);
+            break;
+        }
+        case ArgType::kPointer:
+        {
+            uint64_t v;
+            if (!takeRaw(p, end, &v)) return false;
+            out.append("0x");
+            appendNumber(out, v, 16);
+            break;
+        }
+        case ArgType::kString:
+        {
+            uint32_t len;
+            if (!takeRaw(p, end, &len) || static_cast<size_t>(end - p) < len) return false;
+            out.append(p, len);
+            p += len;
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool decode(FILE* in, FILE* out)
+{
+    char magic[sizeof kMagic];
+    int64_t baseMicros = 0;
+    int64_t baseMonoNs = 0;
+    if (::fread(magic, 1, sizeof magic, in) != sizeof magic || memcmp(magic, kMagic, sizeof magic) != 0 ||
+        !readRaw(in, &baseMicros) || !readRaw(in, &baseMonoNs))
+    {
+        return false;
+    }
+
+    std::vector<Site> sites;
+    std::string record;
+    std::string line;
+    uint8_t kind;
+    while (readRaw(in, &kind))
+    {
+        if (kind == kSiteEntry)
+        {
+            uint32_t id;
+            int32_t lineNo;
+            uint8_t level;
+            uint16_t fileLen;
+            if (!readRaw(in, &id) || !readRaw(in, &lineNo) || !readRaw(in, &level) || !readRaw(in, &fileLen))
+            {
+                return false;
+            }
+            std::string file(fileLen, '\0');
+            if (::fread(&file[0], 1, fileLen, in) != fileLen)
+            {
+                return false;
+            }
+            if (id == 0)
+            {
+                return false;
+            }
+            if (sites.size() < id)
+            {
+                sites.resize(id);
+            }
+            sites[id - 1] = Site{std::move(file), lineNo, static_cast<LogLevel>(level)};
+        }
+        else if (kind == kRecordEntry)
+        {
+            uint32_t len;
+            if (!readRaw(in, &len) || len < kRecordHeaderSize)
+            {
+                return false;
+            }
+            record.resize(len);
+            if (::fread(&record[0], 1, len, in) != len)
+            {
+                return false;
+            }
+            const char* p = record.data();
+            const char* end = p + len;
+            uint32_t id;
+            int64_t monoNs;
+            if (!takeRaw(p, end, &id) || !takeRaw(p, end, &monoNs) || id == 0 || id > sites.size())
+            {
+                return false;
+            }
+            const Site& site = sites[id - 1];
+
+            line.clear();
+            appendTime(line, baseMicros + (monoNs - baseMonoNs) / MonoTime::kNanoSecondsPerMicroSecond);
+            line.append(levelName(site.level));
+            line.push_back(' ');
+            line.append(site.file);
+            line.push_back(':');
+            appendNumber(line, site.line);
+            line.push_back(' ');
+            if (!appendArgs(line, p, end))
+            {
+                return false;
+            }
+            line.push_back('\n');
+            ::fwrite(line.data(), 1, line.size(), out);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace binlog
@@ -0,0 +1,204 @@
+// base/BinaryLog.h
+
+#ifndef BINARYLOG_H
+#define BINARYLOG_H
+
+#include "Logger.h"
+#include "LogBuffer.h"
+#include "MonoTime.h"
+#include "noncopyable.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class LogRing;
+
+/**
+ * @brief 二进制日志 (延迟格式化)：调用线程不做任何文本格式化。
+ * - 每个 LOG 调用点有一个静态的 LogSite (文件、行号、级别)，首次执行时注册得到一个 id；
+ * - 一条日志记录为 [site id][MonoTime 纳秒][参数...]，每个参数是 1 字节类型 + 原始字节，
+ *   字符串拷贝内容，写进当前线程的 LogRing；
+ * - 写线程把各线程的记录连同新注册的 LogSite 字典一起写入二进制文件；
+ * - 离线用 binlog_decode 工具还原成与 LogStream 完全相同的文本。
+ * 编译时定义 MYMUDUO_BINARY_LOG (CMake 选项 MYMUDUO_BINARY_LOG=ON) 后 LOG_* 宏改为走这条路径，
+ * 也可以直接使用 BINLOG_* 宏。
+ */
+
+// 一个 LOG 调用点，静态存储、常量初始化，访问时没有局部静态变量的初始化检查
+struct LogSite
+{
+    constexpr LogSite(SourceFile sourceFile, int sourceLine, LogLevel sourceLevel)
+        : file(sourceFile),
+          line(sourceLine),
+          level(sourceLevel),
+          id(0)
+    {}
+
+    const SourceFile file;
+    const int line;
+    const LogLevel level;
+    std::atomic<uint32_t> id; // 0 表示尚未注册
+};
+
+// 文件格式：
+//   文件头  kMagic (8 字节) | int64 打开时的 Timestamp 微秒 | int64 同一时刻的 MonoTime 纳秒
+//   字典项  uint8 kSiteEntry | uint32 id | int32 line | uint8 level | uint16 文件名长度 | 文件名
+//   记录    uint8 kRecordEntry | uint32 长度 | uint32 site id | int64 MonoTime 纳秒 | 参数...
+// 字典项总是出现在引用它的记录之前；整数按本机字节序
+namespace binlog
+{
+
+const char kMagic[8] = {'M', 'M', 'B', 'L', 'O', 'G', '1', '\0'};
+const uint8_t kSiteEntry = 1;
+const uint8_t kRecordEntry = 2;
+
+enum class ArgType : uint8_t
+{
+    kBool = 1,
+    kInt32,
+    kUInt32,
+    kInt64,
+    kUInt64,
+    kDouble,
+    kChar,
+    kPointer,
+    kString, // uint32 长度 + 内容
+};
+
+// 把 in 中的二进制日志还原成文本写到 out，格式错误时返回 false
+bool decode(FILE* in, FILE* out);
+
+} // namespace binlog
+
+// 二进制日志的写线程和每线程的环 (单例)
+class BinaryLogger : noncopyable
+{
+public:
+    static BinaryLogger& getInstance();
+
+    // 应在第一条二进制日志之前调用，默认写到当前目录的 mymuduo.binlog
+    void setFile(const std::string& filename);
+    // 等待写线程把已有的记录写进文件
+    void flush();
+
+    uint32_t registerSite(LogSite& site);
+    // 当前线程的环满时按 Logger::setOverflowPolicy 的策略等待或丢弃，丢弃数计入 Logger::droppedMessages()
+    void append(const char* record, size_t len);
+
+private:
+    BinaryLogger();
+    ~BinaryLogger();
+
+    static constexpr size_t kThreadRingSize = 256 * 1024;
+
+    void writerThreadFunc();
+    LogRing* threadRing();
+    // 把所有环里的记录按文件格式追加到 m_batch，返回记录数
+    size_t drainRings();
+    void writeBatch();
+    void wakeWriter();
+    bool ringsEmpty();
+
+    std::mutex m_writeMutex;                    // 取环和写文件在同一把锁里，flush 借它等最后一批写完
+    std::string m_filename;
+    FILE* m_fp;                                 // 写线程在第一批数据到来时打开
+    std::string m_batch;                        // 写线程私有
+
+    std::mutex m_sitesMutex;
+    std::vector<const LogSite*> m_sites;        // 下标 + 1 即 id
+    size_t m_sitesWritten;                      // 已写入文件的字典项数，写线程私有
+
+    std::mutex m_ringsMutex;
+    std::vector<std::shared_ptr<LogRing>> m_rings;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCond;
+    std::atomic<bool> m_writerSleeping;
+    std::atomic<bool> m_exiting;
+    std::thread m_writerThread;
+};
+
+/**
+ * @brief 一条二进制日志：与 LogStream 有相同的 operator<< 重载，但只记录类型和原始字节。
+ * 与 LogStream 一样，缓冲区快满时字符串截断，数字放不下就整个丢弃。
+ */
+class BinaryLogStream
+{
+public:
+    explicit BinaryLogStream(LogSite& site);
+    ~BinaryLogStream();
+
+    BinaryLogStream& operator<<(bool v) { return put(binlog::ArgType::kBool, static_cast<uint8_t>(v)); }
+    BinaryLogStream& operator<<(short v) { return put(binlog::ArgType::kInt32, static_cast<int32_t>(v)); }
+    BinaryLogStream& operator<<(unsigned short v) { return put(binlog::ArgType::kUInt32, static_cast<uint32_t>(v)); }
+    BinaryLogStream& operator<<(int v) { return put(binlog::ArgType::kInt32, static_cast<int32_t>(v)); }
+    BinaryLogStream& operator<<(unsigned int v) { return put(binlog::ArgType::kUInt32, static_cast<uint32_t>(v)); }
+    BinaryLogStream& operator<<(long v) { return put(binlog::ArgType::kInt64, static_cast<int64_t>(v)); }
+    BinaryLogStream& operator<<(unsigned long v) { return put(binlog::ArgType::kUInt64, static_cast<uint64_t>(v)); }
+    BinaryLogStream& operator<<(long long v) { return put(binlog::ArgType::kInt64, static_cast<int64_t>(v)); }
+    BinaryLogStream& operator<<(unsigned long long v) { return put(binlog::ArgType::kUInt64, static_cast<uint64_t>(v)); }
+    BinaryLogStream& operator<<(const void* p) { return put(binlog::ArgType::kPointer, reinterpret_cast<uint64_t>(p)); }
+    BinaryLogStream& operator<<(float v) { return put(binlog::ArgType::kDouble, static_cast<double>(v)); }
+    BinaryLogStream& operator<<(double v) { return put(binlog::ArgType::kDouble, v); }
+    BinaryLogStream& operator<<(char v) { return put(binlog::ArgType::kChar, v); }
+
+    BinaryLogStream& operator<<(const char* str)
+    {
+        return str ? putString(str, strlen(str)) : putString("(null)", 6);
+    }
+    BinaryLogStream& operator<<(const unsigned char* str)
+    {
+        return operator<<(reinterpret_cast<const char*>(str));
+    }
+    BinaryLogStream& operator<<(std::string_view v) { return putString(v.data(), v.size()); }
+    BinaryLogStream& operator<<(const std::string& v) { return putString(v.data(), v.size()); }
+
+private:
+    template<typename T>
+    BinaryLogStream& put(binlog::ArgType type, T value)
+    {
+        if (static_cast<size_t>(m_buffer.avail()) > 1 + sizeof(T))
+        {
+            char* p = m_buffer.current();
+            p[0] = static_cast<char>(type);
+            memcpy(p + 1, &value, sizeof(T));
+            m_buffer.add(1 + sizeof(T));
+        }
+        return *this;
+    }
+
+    BinaryLogStream& putString(const char* str, size_t len);
+
+    FixedBuffer<kSmallBuffer> m_buffer;
+    LogLevel m_level;
+};
+
+// 每个展开点一个 lambda，因而一个独立的静态 LogSite
+#define BINLOG_SITE(level) \
+    ([]() -> LogSite& { static LogSite site(LOG_SOURCE_FILE, __LINE__, level); return site; }())
+
+#define BINLOG_INFO \
+    if (logEnabled(INFO, LOG_SOURCE_FILE)) \
+        BinaryLogStream(BINLOG_SITE(INFO))
+
+#define BINLOG_DEBUG \
+    if (logEnabled(DEBUG, LOG_SOURCE_FILE)) \
+        BinaryLogStream(BINLOG_SITE(DEBUG))
+
+#define BINLOG_ERROR \
+    if (logEnabled(ERROR, LOG_SOURCE_FILE)) \
+        BinaryLogStream(BINLOG_SITE(ERROR))
+
+#define BINLOG_FATAL \
+    if (logEnabled(FATAL, LOG_SOURCE_FILE)) \
+        BinaryLogStream(BINLOG_SITE(FATAL))
+
+#endif
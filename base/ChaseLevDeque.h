@@ -0,0 +1,151 @@
+// base/ChaseLevDeque.h
+
+#ifndef CHASELEVDEQUE_H
+#define CHASELEVDEQUE_H
+
+#include "noncopyable.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Chase-Lev 工作窃取双端队列 (按 Lê 等人 2013 年给出的 C11 内存序版本实现)。
+ * - 只有所有者线程调用 push / take，在底部 (bottom) 进出，后进先出，缓存更热；
+ * - 其它线程调用 steal，从顶部 (top) 取最旧的元素，彼此之间以及与 take 之间用 CAS 仲裁最后一个元素；
+ * - 元素是指针，满了由所有者扩容为两倍；旧数组可能仍被窃取者读取，保留到析构时才释放。
+ */
+template<typename T>
+class ChaseLevDeque : noncopyable
+{
+public:
+    explicit ChaseLevDeque(size_t capacity = 1024)
+        : m_top(0),
+          m_bottom(0)
+    {
+        m_arrays.emplace_back(new Array(roundUpPowerOfTwo(capacity)));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    // 所有者线程
+    void push(T* item)
+    {
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_acquire);
+        Array* array = m_array.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(array->capacity()) - 1)
+        {
+            array = grow(array, t, b);
+        }
+        array->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // 所有者线程，空时返回 nullptr
+    T* take()
+    {
+        int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array* array = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+
+        T* item = nullptr;
+        if (t <= b)
+        {
+            item = array->get(b);
+            if (t == b)
+            {
+                // 只剩最后一个：与窃取者竞争
+                if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // 任意线程；空或者竞争失败时返回 nullptr
+    T* steal()
+    {
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b)
+        {
+            return nullptr;
+        }
+        // 标准里的 consume，这里用 acquire 代替
+        Array* array = m_array.load(std::memory_order_acquire);
+        T* item = array->get(t);
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return item;
+    }
+
+    // 近似值，只用于判断是否值得去偷
+    bool empty() const
+    {
+        return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+    }
+
+private:
+    class Array
+    {
+    public:
+        explicit Array(size_t capacity)
+            : m_mask(capacity - 1),
+              m_slots(new std::atomic<T*>[capacity])
+        {}
+
+        size_t capacity() const { return m_mask + 1; }
+        T* get(int64_t index) const { return m_slots[index & m_mask].load(std::memory_order_relaxed); }
+        void put(int64_t index, T* item) { m_slots[index & m_mask].store(item, std::memory_order_relaxed); }
+
+    private:
+        const size_t m_mask;
+        std::unique_ptr<std::atomic<T*>[]> m_slots;
+    };
+
+    Array* grow(Array* old, int64_t top, int64_t bottom)
+    {
+        m_arrays.emplace_back(new Array(old->capacity() * 2));
+        Array* array = m_arrays.back().get();
+        for (int64_t i = top; i < bottom; ++i)
+        {
+            array->put(i, old->get(i));
+        }
+        m_array.store(array, std::memory_order_release);
+        return array;
+    }
+
+    static size_t roundUpPowerOfTwo(size_t n)
+    {
+        size_t size = 2;
+        while (size < n)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    static const size_t kCacheLineSize = 64;
+
+    alignas(kCacheLineSize) std::atomic<int64_t> m_top;    // 窃取者 CAS
+    alignas(kCacheLineSize) std::atomic<int64_t> m_bottom; // 所有者写
+    std::atomic<Array*> m_array;
+    std::vector<std::unique_ptr<Array>> m_arrays;          // 所有者私有，包括已被替换的旧数组
+};
+
+#endif
@@ -0,0 +1,29 @@
+// base/Futex.h
+
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// futex 的薄封装，只用于进程内 (PRIVATE)。
+// futexWait：*word 仍等于 expected 时休眠，直到被唤醒、超时 (timeout 为相对时间，nullptr 表示不限) 或被信号打断；
+// 调用者醒来后总是要重新检查自己的条件。
+inline int futexWait(std::atomic<uint32_t>* word, uint32_t expected, const struct timespec* timeout = nullptr)
+{
+    return static_cast<int>(::syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT_PRIVATE,
+                                      expected, timeout, nullptr, 0));
+}
+
+// 唤醒最多 count 个在 word 上休眠的线程
+inline int futexWake(std::atomic<uint32_t>* word, int count)
+{
+    return static_cast<int>(::syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE,
+                                      count, nullptr, nullptr, 0));
+}
+
+#endif
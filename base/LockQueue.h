@@ -3,30 +3,71 @@
 #ifndef LOCKQUEUE_H
 #define LOCKQUEUE_H
 
-#include <queue>
+#include <algorithm>
+#include <deque>
+#include <vector>
 #include <mutex>
+#include <chrono>
+#include <utility>
 #include <condition_variable>
 #include <optional> // 1. 引入 C++17 的 std::optional,nullopt
 
+// 【新增】可选容量上限 (0 表示不限)。满了之后：
+//   Push          阻塞直到有空位
+//   TryPush       直接返回 false (丢弃新的)
+//   PushDropOldest 丢掉队头最旧的一个再放入
+//   PushFor       最多等 timeout，仍然满则返回 false
+// 【新增】所有 Push 都有右值版本，元素只移动不拷贝，T 可以是只能移动的类型；
+// 放入失败时右值参数保持原样，调用者可以自行处理。
+// PopAll / PopBatch 一次加锁取走多个元素，追加到调用者的 vector (可以复用，避免反复分配)。
+// 还有其它消费者在等待时，PopBatch 只取 (元素个数 / 消费者个数) 的一份，
+// 免得一个消费者把几个长任务都揽走、别的消费者闲着；PopAll 不平分，总是取走全部。
 template<typename T>
 class LockQueue
 {
 public:
-    LockQueue() : m_shutdown(false) {}
+    explicit LockQueue(size_t capacity = 0) : m_capacity(capacity), m_popWaiters(0), m_shutdown(false) {}
 
-    void Push(const T& data)
+    void setCapacity(size_t capacity)
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_shutdown) return; // 关闭后不再接受新任务
-        m_queue.push(data);
-        m_condvariable.notify_one();
+        m_capacity = capacity;
+        m_notFull.notify_all();
+    }
+
+    void Push(const T& data) { pushImpl(data); }
+    void Push(T&& data) { pushImpl(std::move(data)); }
+
+    bool TryPush(const T& data) { return tryPushImpl(data); }
+    bool TryPush(T&& data) { return tryPushImpl(std::move(data)); }
+
+    // 返回是否丢弃了旧元素
+    bool PushDropOldest(const T& data) { return pushDropOldestImpl(data); }
+    bool PushDropOldest(T&& data) { return pushDropOldestImpl(std::move(data)); }
+
+    template<typename Rep, typename Period>
+    bool PushFor(const T& data, std::chrono::duration<Rep, Period> timeout)
+    {
+        return pushForImpl(data, timeout);
+    }
+
+    template<typename Rep, typename Period>
+    bool PushFor(T&& data, std::chrono::duration<Rep, Period> timeout)
+    {
+        return pushForImpl(std::move(data), timeout);
+    }
+
+    size_t Size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.size();
     }
 
     // 2. 修改 Pop 返回类型为 std::optional<T>
     std::optional<T> Pop()
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        
+
         m_condvariable.wait(lock, [this] {
             return !m_queue.empty() || m_shutdown;
         });
@@ -36,24 +77,163 @@ public:
             return std::nullopt;
         }
 
-        T data = m_queue.front();
-        m_queue.pop();
+        std::optional<T> data(std::move(m_queue.front()));
+        m_queue.pop_front();
+        if (m_capacity > 0)
+        {
+            m_notFull.notify_one();
+        }
         return data;
     }
 
+    // 不等待，队列为空时返回 nullopt
+    std::optional<T> TryPop()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.empty())
+        {
+            return std::nullopt;
+        }
+        std::optional<T> data(std::move(m_queue.front()));
+        m_queue.pop_front();
+        if (m_capacity > 0)
+        {
+            m_notFull.notify_one();
+        }
+        return data;
+    }
+
+    // 等到至少有一个元素，取走最多 maxItems 个追加到 out；队列已关闭且为空时返回 false
+    bool PopBatch(std::vector<T>& out, size_t maxItems)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ++m_popWaiters;
+        m_condvariable.wait(lock, [this] {
+            return !m_queue.empty() || m_shutdown;
+        });
+        --m_popWaiters;
+        return takeLocked(out, std::min(maxItems, fairShareLocked()));
+    }
+
+    // 同 PopBatch，但最多等 timeout；超时也返回 false
+    template<typename Rep, typename Period>
+    bool PopBatchFor(std::vector<T>& out, size_t maxItems, std::chrono::duration<Rep, Period> timeout)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ++m_popWaiters;
+        m_condvariable.wait_for(lock, timeout, [this] {
+            return !m_queue.empty() || m_shutdown;
+        });
+        --m_popWaiters;
+        return takeLocked(out, std::min(maxItems, fairShareLocked()));
+    }
+
+    // 等到至少有一个元素，取走队列中的全部元素 (不与其它等待的消费者平分)；队列已关闭且为空时返回 false
+    bool PopAll(std::vector<T>& out)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ++m_popWaiters;
+        m_condvariable.wait(lock, [this] {
+            return !m_queue.empty() || m_shutdown;
+        });
+        --m_popWaiters;
+        return takeLocked(out, m_queue.size());
+    }
+
     // 4. 新增 Shutdown 方法
     void Shutdown()
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_shutdown = true;
         m_condvariable.notify_all(); // 唤醒所有线程
+        m_notFull.notify_all();
     }
 
 private:
-    std::queue<T> m_queue;
-    std::mutex m_mutex;
+    bool full() const { return m_capacity > 0 && m_queue.size() >= m_capacity; }
+
+    // 与仍在等待的消费者平分 (向上取整)
+    size_t fairShareLocked() const
+    {
+        return (m_queue.size() + m_popWaiters) / (m_popWaiters + 1);
+    }
+
+    // 取走最多 n 个；队列为空时返回 false
+    bool takeLocked(std::vector<T>& out, size_t n)
+    {
+        if (m_queue.empty())
+        {
+            return false;
+        }
+        n = std::min(n, m_queue.size());
+        for (size_t i = 0; i < n; ++i)
+        {
+            out.push_back(std::move(m_queue.front()));
+            m_queue.pop_front();
+        }
+        if (m_capacity > 0)
+        {
+            m_notFull.notify_all(); // 可能腾出了多个空位
+        }
+        return true;
+    }
+
+    template<typename U>
+    void pushImpl(U&& data)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] { return !full() || m_shutdown; });
+        if (m_shutdown) return; // 关闭后不再接受新任务
+        m_queue.push_back(std::forward<U>(data));
+        m_condvariable.notify_one();
+    }
+
+    template<typename U>
+    bool tryPushImpl(U&& data)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shutdown || full()) return false;
+        m_queue.push_back(std::forward<U>(data));
+        m_condvariable.notify_one();
+        return true;
+    }
+
+    template<typename U>
+    bool pushDropOldestImpl(U&& data)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_shutdown) return false;
+        bool dropped = false;
+        if (full())
+        {
+            m_queue.pop_front();
+            dropped = true;
+        }
+        m_queue.push_back(std::forward<U>(data));
+        m_condvariable.notify_one();
+        return dropped;
+    }
+
+    template<typename U, typename Rep, typename Period>
+    bool pushForImpl(U&& data, std::chrono::duration<Rep, Period> timeout)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_notFull.wait_for(lock, timeout, [this] { return !full() || m_shutdown; }) || m_shutdown)
+        {
+            return false;
+        }
+        m_queue.push_back(std::forward<U>(data));
+        m_condvariable.notify_one();
+        return true;
+    }
+
+    std::deque<T> m_queue;
+    mutable std::mutex m_mutex;
     std::condition_variable m_condvariable;
+    std::condition_variable m_notFull; // 有容量上限时，等待空位的生产者
+    size_t m_capacity;
+    size_t m_popWaiters; // 阻塞在 PopBatch / PopBatchFor 里的消费者
     bool m_shutdown; // 关闭标志
 };
 
-#endif
\ No newline at end of file
+#endif
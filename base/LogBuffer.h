@@ -0,0 +1,55 @@
+// base/LogBuffer.h
+
+#ifndef LOGBUFFER_H
+#define LOGBUFFER_H
+
+#include "noncopyable.h"
+
+#include <cstring>
+#include <string>
+
+const int kSmallBuffer = 4000;             // 单条日志
+const int kLargeBuffer = 4 * 1024 * 1024;  // AsyncLogging 的前后端缓冲区
+
+/**
+ * @brief 定长缓冲区，容量在编译期确定。
+ * 只追加不扩容，放不下时 append 直接丢弃这一段，由调用者先用 avail() 判断。
+ */
+template<int SIZE>
+class FixedBuffer : noncopyable
+{
+public:
+    FixedBuffer()
+        : m_cur(m_data)
+    {}
+
+    void append(const char* buf, size_t len)
+    {
+        if (static_cast<size_t>(avail()) > len)
+        {
+            memcpy(m_cur, buf, len);
+            m_cur += len;
+        }
+    }
+
+    const char* data() const { return m_data; }
+    int length() const { return static_cast<int>(m_cur - m_data); }
+
+    // 直接写入 current()，再用 add() 移动写指针 (用于就地格式化数字)
+    char* current() { return m_cur; }
+    int avail() const { return static_cast<int>(end() - m_cur); }
+    void add(size_t len) { m_cur += len; }
+
+    void reset() { m_cur = m_data; }
+    void bzero() { memset(m_data, 0, sizeof m_data); }
+
+    std::string toString() const { return std::string(m_data, length()); }
+
+private:
+    const char* end() const { return m_data + sizeof m_data; }
+
+    char m_data[SIZE];
+    char* m_cur;
+};
+
+#endif
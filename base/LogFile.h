@@ -0,0 +1,68 @@
+// base/LogFile.h
+
+#ifndef LOGFILE_H
+#define LOGFILE_H
+
+#include "noncopyable.h"
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <sys/types.h>
+
+/**
+ * @brief 按大小和时间滚动的日志文件，只由一个线程使用 (AsyncLogging 的后端线程)。
+ * - 文件名为 basename.YYYYmmdd-HHMMSS.uuuuuu.pid.log，按字典序即按创建顺序；
+ * - 写入量达到 rollSize 或跨过 rollInterval 的整数倍时换新文件；
+ * - flush 只做 fflush，另按 fsyncInterval 秒的节奏 fdatasync，避免每次刷新都等磁盘；
+ * - preallocate 时新文件打开后先 fallocate(KEEP_SIZE) rollSize 字节，
+ *   写入时不再逐块分配磁盘空间，文件大小仍然只反映实际写入的内容。
+ * rollSize 和 rollInterval 都为 0 时不滚动，直接追加写入 basename 本身。
+ */
+class LogFile : noncopyable
+{
+public:
+    struct Options
+    {
+        off_t rollSize = 64 * 1024 * 1024; // 字节，0 表示不按大小滚动
+        int rollInterval = 24 * 60 * 60;    // 秒，按本地时间对齐；0 表示不按时间滚动
+        int fsyncInterval = 0;              // 秒，0 表示从不 fdatasync，交给内核回写
+        bool preallocate = false;
+    };
+
+    LogFile(const std::string& basename, const Options& options);
+    ~LogFile();
+
+    void append(const char* logline, size_t len);
+    // 写出 stdio 缓冲区；距上次 fdatasync 超过 fsyncInterval 时顺带落盘
+    void flush();
+    // 检查时间滚动，后端空闲 (没有 append) 时也要按时换文件
+    void rollIfNeeded(time_t now);
+
+    // 当前文件名，不滚动时为 basename
+    const std::string& filename() const { return m_filename; }
+
+private:
+    // 比系统默认的 4KB 大，每个 4MB 缓冲区只需要少量 write
+    static const size_t kFileBufferSize = 64 * 1024;
+
+    void rollFile(time_t now);
+    void openFile(const std::string& filename);
+    void closeFile();
+    std::string nextFilename() const;
+    time_t periodStart(time_t now) const;
+
+    const std::string m_basename;
+    const Options m_options;
+    const bool m_rolling;
+
+    FILE* m_fp;
+    std::string m_filename;
+    char m_fileBuffer[kFileBufferSize];
+    off_t m_writtenBytes;  // 当前文件已写入的字节数
+    time_t m_period;       // 当前文件所属时间段的起点
+    time_t m_lastFsync;
+    bool m_dirty;          // 上次 fdatasync 之后有新数据
+};
+
+#endif
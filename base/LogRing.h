@@ -0,0 +1,130 @@
+// base/LogRing.h
+
+#ifndef LOGRING_H
+#define LOGRING_H
+
+#include "noncopyable.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/**
+ * @brief 单生产者/单消费者的变长记录字节环，每个打日志的线程一个。
+ * 记录格式为 [uint32 长度][内容]，按 4 字节对齐；尾部放不下时写一个回绕标记，从头继续。
+ * 生产者只写 m_tail，消费者只写 m_head，用 acquire/release 配对，不加锁、不分配内存。
+ * 消费者一次取走当前所有记录后才推进 m_head，生产者看到的是成批释放的空间。
+ */
+class LogRing : noncopyable
+{
+public:
+    // capacity 向上取整为 2 的幂
+    explicit LogRing(size_t capacity)
+        : m_capacity(roundUpPowerOfTwo(capacity)),
+          m_mask(m_capacity - 1),
+          m_data(new char[m_capacity]),
+          m_head(0),
+          m_tail(0),
+          m_cachedHead(0),
+          m_closed(false)
+    {}
+
+    // 单条记录的最大长度，更长的由调用者截断
+    size_t maxRecordSize() const { return m_capacity / 2 - kHeaderSize; }
+
+    // 生产者线程调用，空间不足时返回 false
+    bool TryWrite(const char* data, size_t len)
+    {
+        const size_t need = kHeaderSize + alignUp(len);
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t offset = tail & m_mask;
+        size_t toEnd = m_capacity - offset;
+        size_t total = need <= toEnd ? need : toEnd + need;
+
+        if (m_capacity - (tail - m_cachedHead) < total)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (m_capacity - (tail - m_cachedHead) < total)
+            {
+                return false;
+            }
+        }
+
+        if (need > toEnd)
+        {
+            // 尾部放不下整条记录：写回绕标记 (对齐保证至少还有 4 字节)，从缓冲区开头写
+            uint32_t marker = kWrapMarker;
+            memcpy(m_data.get() + offset, &marker, kHeaderSize);
+            tail += toEnd;
+            offset = 0;
+        }
+        uint32_t header = static_cast<uint32_t>(len);
+        memcpy(m_data.get() + offset, &header, kHeaderSize);
+        memcpy(m_data.get() + offset + kHeaderSize, data, len);
+        m_tail.store(tail + need, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用：对当前所有记录依次调用 func(data, len)，返回处理的记录数
+    template<typename Func>
+    size_t Consume(Func&& func)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        size_t count = 0;
+        while (head != tail)
+        {
+            size_t offset = head & m_mask;
+            uint32_t header;
+            memcpy(&header, m_data.get() + offset, kHeaderSize);
+            if (header == kWrapMarker)
+            {
+                head += m_capacity - offset;
+                continue;
+            }
+            func(m_data.get() + offset + kHeaderSize, static_cast<size_t>(header));
+            head += kHeaderSize + alignUp(header);
+            ++count;
+        }
+        m_head.store(head, std::memory_order_release);
+        return count;
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    // 生产者线程退出时标记，消费者取空后即可丢弃
+    void close() { m_closed.store(true, std::memory_order_release); }
+    bool closed() const { return m_closed.load(std::memory_order_acquire); }
+
+private:
+    static const size_t kHeaderSize = sizeof(uint32_t);
+    static const uint32_t kWrapMarker = UINT32_MAX;
+    static const size_t kCacheLineSize = 64;
+
+    static size_t alignUp(size_t len) { return (len + kHeaderSize - 1) & ~(kHeaderSize - 1); }
+
+    static size_t roundUpPowerOfTwo(size_t n)
+    {
+        size_t size = 64;
+        while (size < n)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    const size_t m_capacity;
+    const size_t m_mask;
+    std::unique_ptr<char[]> m_data;
+
+    alignas(kCacheLineSize) std::atomic<size_t> m_head; // 消费者写
+    alignas(kCacheLineSize) std::atomic<size_t> m_tail; // 生产者写
+    alignas(kCacheLineSize) size_t m_cachedHead;        // 生产者私有
+    std::atomic<bool> m_closed;
+};
+
+#endif
@@ -1,8 +1,19 @@
 // base/Logger.cpp
 // 实现日志输出的逻辑就是靠logger实例不断Pop(),需要的时候就会调用loggerstream的构造函数,构造出头部 信息,靠析构函数调用log和<<把buffer的内容push到队列.
 #include "Logger.h"
+#include "LogRing.h"
+#include "MonoTime.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <charconv>
+#include <cstring>
+#include <ctime>
 #include <iostream>
 
+std::atomic<int> g_logThreshold(INFO);
+std::atomic<bool> g_logModuleOverrides(false);
+
 // === Logger 方法的实现 ===
 Logger& Logger::getInstance()
 {
@@ -10,34 +21,104 @@ Logger& Logger::getInstance()
     return logger;
 }
 
-// 被创造出来的时候就一直在寻找工作并完成
-// 并且是唯一实例
-Logger::Logger() : m_logLevel(INFO)
+namespace
+{
+
+// 线程退出时关闭自己的环，写线程取空后把它移出列表
+struct ThreadRingHolder
 {
-    m_writerThread = std::thread([this]() {
-        while (true)
+    std::shared_ptr<LogRing> ring;
+
+    ~ThreadRingHolder()
+    {
+        if (ring)
         {
-            // Pop 现在返回一个 optional，可以判断是否有效
-            auto result = m_logQueue.Pop();
+            ring->close();
+        }
+    }
+};
 
-            if (result.has_value())
-            {
-                // 如果 optional 有值，就取出值并打印
-                std::cout << result.value(); 
-            }
-            else // 如果返回的是空 optional，说明队列已关闭且为空
-            {
-                break; // 收到“下班”信号，退出循环
-            }
+thread_local ThreadRingHolder t_ringHolder;
+
+// 写线程没有被唤醒时的兜底轮询间隔
+const int kWriterIdleWaitMs = 100;
+// flush 等待写线程的最长时间
+const int kFlushTimeoutMs = 1000;
+
+// LockQueue 中的标记消息："\0" + 序号，正常日志以日期开头，不会以 '\0' 开头
+const char kMarkerPrefix = '\0';
+
+bool isMarker(const std::string& msg)
+{
+    return !msg.empty() && msg[0] == kMarkerPrefix;
+}
+
+uint64_t markerSequence(const std::string& msg)
+{
+    return std::stoull(msg.substr(1));
+}
+
+// 模块级覆盖表：只追加不删除，读者无锁扫描 (先读 count，再读前 count 项)
+const size_t kMaxModuleOverrides = 32;
+const size_t kMaxModuleNameLength = 64;
+const int kInheritLevel = -1; // 跟随全局级别
+
+struct ModuleOverride
+{
+    char name[kMaxModuleNameLength];
+    size_t length;
+    std::atomic<int> level;
+};
+
+ModuleOverride g_moduleOverrides[kMaxModuleOverrides];
+std::atomic<size_t> g_moduleOverrideCount(0);
+
+ModuleOverride* findModule(const char* name, size_t length)
+{
+    size_t count = g_moduleOverrideCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ModuleOverride& module = g_moduleOverrides[i];
+        if (module.length == length && memcmp(module.name, name, length) == 0)
+        {
+            return &module;
         }
-    });
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// 被创造出来的时候就一直在寻找工作并完成
+// 并且是唯一实例
+Logger::Logger()
+    : m_logLevel(INFO),
+      m_queueMode(QueueMode::kThreadRings),
+      m_logQueue(kDefaultQueueCapacity),
+      m_queueCapacity(kDefaultQueueCapacity),
+      m_markersSent(0),
+      m_markersDone(0),
+      m_overflowPolicy(OverflowPolicy::kBlock),
+      m_blockTimeoutMs(kDefaultBlockTimeoutMs),
+      m_dropped(0),
+      m_droppedReported(0),
+      m_writerSleeping(false),
+      m_exiting(false)
+{
+    m_writerThread = std::thread(&Logger::writerThreadFunc, this);
 }
 
 // 【核心重构】更新析构函数以匹配新的 LockQueue 接口
 Logger::~Logger()
 {
+    m_exiting.store(true);
     // 只需调用队列的 Shutdown 方法
     m_logQueue.Shutdown();
+    if (m_mpmcQueue)
+    {
+        m_mpmcQueue->Shutdown();
+    }
+    wakeWriter();
     // 等待后台线程处理完所有剩余消息并安全退出
     if (m_writerThread.joinable())
     {
@@ -45,40 +126,642 @@ Logger::~Logger()
     }
 }
 
+void Logger::writeOut(const char* msg, size_t len)
+{
+    fwrite(msg, 1, len, stdout);
+}
+
+// 【修改】一次取走队列里的全部消息 (LockQueue 只加一次锁)
+template<typename Queue>
+bool Logger::writeQueued(Queue& queue, std::vector<std::string>& batch)
+{
+    batch.clear();
+    if (!queue.PopAll(batch))
+    {
+        return false;
+    }
+    for (const std::string& message : batch)
+    {
+        if (isMarker(message))
+        {
+            // flush / setQueueMode 放入的标记；kDropOldest 可能丢掉标记，所以记录见到的最大序号
+            std::cout.flush();
+            uint64_t marker = markerSequence(message);
+            if (marker > m_markersDone.load(std::memory_order_relaxed))
+            {
+                m_markersDone.store(marker);
+            }
+            continue;
+        }
+        std::cout << message;
+    }
+    reportDropped();
+    return true;
+}
+
+void Logger::writerThreadFunc()
+{
+    std::vector<std::string> batch; // 队列模式下每次取出的消息，复用容量
+    while (true)
+    {
+        QueueMode mode = m_queueMode.load(std::memory_order_acquire);
+        if (mode != QueueMode::kThreadRings)
+        {
+            drainRings(); // 切换模式前留在环里的消息
+            // 返回 false 说明队列已关闭且为空，收到“下班”信号
+            bool open = mode == QueueMode::kLockQueue ? writeQueued(m_logQueue, batch)
+                                                      : writeQueued(*m_mpmcQueue, batch);
+            if (!open)
+            {
+                break;
+            }
+            continue;
+        }
+
+        if (drainRings() > 0)
+        {
+            reportDropped();
+            fflush(stdout); // 每批只 flush 一次
+            continue;
+        }
+        if (m_exiting.load())
+        {
+            break;
+        }
+
+        // 所有环都空了才睡：先声明要睡，再检查一遍，避免与生产者的 push 错过
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_writerSleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool empty = true;
+        {
+            std::lock_guard<std::mutex> ringsLock(m_ringsMutex);
+            for (const auto& ring : m_rings)
+            {
+                if (!ring->empty())
+                {
+                    empty = false;
+                    break;
+                }
+            }
+        }
+        if (empty && !m_exiting.load())
+        {
+            m_wakeCond.wait_for(lock, std::chrono::milliseconds(kWriterIdleWaitMs));
+        }
+        m_writerSleeping.store(false);
+    }
+
+    // 退出前把两种队列里剩下的都写完 (Shutdown 之后 Pop 不会阻塞)
+    drainRings();
+    batch.clear();
+    m_logQueue.PopAll(batch);
+    if (m_mpmcQueue)
+    {
+        m_mpmcQueue->PopAll(batch);
+    }
+    for (const std::string& message : batch)
+    {
+        if (!isMarker(message))
+        {
+            std::cout << message;
+        }
+    }
+    fflush(stdout);
+}
+
+size_t Logger::drainRings()
+{
+    size_t count = 0;
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    for (auto it = m_rings.begin(); it != m_rings.end();)
+    {
+        // 先读 closed 再取数据：线程退出前写入的消息一定能在这一轮取到
+        bool closed = (*it)->closed();
+        count += (*it)->Consume(&Logger::writeOut);
+        if (closed)
+        {
+            it = m_rings.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return count;
+}
+
+void Logger::reportDropped()
+{
+    uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_droppedReported)
+    {
+        char buf[128];
+        int len = snprintf(buf, sizeof buf, "Logger: dropped %llu log messages (queue full), %llu in total\n",
+                           static_cast<unsigned long long>(dropped - m_droppedReported),
+                           static_cast<unsigned long long>(dropped));
+        writeOut(buf, static_cast<size_t>(len));
+        m_droppedReported = dropped;
+    }
+}
+
+void Logger::wakeWriter()
+{
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wakeCond.notify_one();
+}
+
+LogRing* Logger::threadRing()
+{
+    if (!t_ringHolder.ring)
+    {
+        t_ringHolder.ring = std::make_shared<LogRing>(kThreadRingSize);
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        m_rings.push_back(t_ringHolder.ring);
+    }
+    return t_ringHolder.ring.get();
+}
+
+void Logger::appendToRing(const char* msg, size_t len)
+{
+    LogRing* ring = threadRing();
+    if (len > ring->maxRecordSize())
+    {
+        len = ring->maxRecordSize();
+    }
+    if (!ring->TryWrite(msg, len))
+    {
+        // 环满说明写线程落后了：确保它醒着，再按策略等待或丢弃
+        wakeWriter();
+        bool written = false;
+        if (m_overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::kBlock)
+        {
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() +
+                std::chrono::milliseconds(m_blockTimeoutMs.load(std::memory_order_relaxed));
+            while (!(written = ring->TryWrite(msg, len)) && std::chrono::steady_clock::now() < deadline)
+            {
+                wakeWriter();
+                std::this_thread::yield();
+            }
+        }
+        if (!written)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    // 只有写线程准备睡眠时才需要加锁通知，正常情况下一次 push 只有几次内存访问
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerSleeping.load(std::memory_order_relaxed))
+    {
+        wakeWriter();
+    }
+}
+
+void Logger::setQueueMode(QueueMode mode)
+{
+    if (mode == QueueMode::kMpmcQueue && !m_mpmcQueue)
+    {
+        // 先创建好再发布模式 (release)，看到 kMpmcQueue 的线程一定能看到队列
+        m_mpmcQueue = std::make_unique<MpmcQueue<std::string>>(m_queueCapacity);
+    }
+    QueueMode old = m_queueMode.exchange(mode, std::memory_order_acq_rel);
+    // 写线程可能阻塞在原来那个队列的 Pop 或者环的等待上，叫醒它重新读模式
+    if (old != mode && old != QueueMode::kThreadRings)
+    {
+        pushMarker(old);
+    }
+    wakeWriter();
+}
+
+uint64_t Logger::pushMarker(QueueMode mode)
+{
+    uint64_t marker = m_markersSent.fetch_add(1) + 1;
+    std::string message = std::string(1, kMarkerPrefix) + std::to_string(marker);
+    if (mode == QueueMode::kMpmcQueue)
+    {
+        m_mpmcQueue->Push(std::move(message));
+    }
+    else
+    {
+        m_logQueue.Push(std::move(message));
+    }
+    return marker;
+}
 
 void Logger::setLogLevel(LogLevel level)
 {
-    m_logLevel = level;
+    std::lock_guard<std::mutex> lock(m_moduleMutex);
+    m_logLevel.store(level, std::memory_order_relaxed);
+    updateThreshold();
+}
+
+void Logger::setModuleLevel(const std::string& module, LogLevel level)
+{
+    std::lock_guard<std::mutex> lock(m_moduleMutex);
+    ModuleOverride* entry = findModule(module.data(), module.size());
+    if (entry == nullptr)
+    {
+        size_t count = g_moduleOverrideCount.load(std::memory_order_relaxed);
+        if (count == kMaxModuleOverrides || module.size() > kMaxModuleNameLength)
+        {
+            fprintf(stderr, "Logger: cannot override level of module %s\n", module.c_str());
+            return;
+        }
+        entry = &g_moduleOverrides[count];
+        memcpy(entry->name, module.data(), module.size());
+        entry->length = module.size();
+        entry->level.store(level, std::memory_order_relaxed);
+        // 先填好表项再发布 count，读者看到的表项都是完整的
+        g_moduleOverrideCount.store(count + 1, std::memory_order_release);
+    }
+    else
+    {
+        entry->level.store(level, std::memory_order_relaxed);
+    }
+    updateThreshold();
+}
+
+void Logger::clearModuleLevel(const std::string& module)
+{
+    std::lock_guard<std::mutex> lock(m_moduleMutex);
+    ModuleOverride* entry = findModule(module.data(), module.size());
+    if (entry != nullptr)
+    {
+        entry->level.store(kInheritLevel, std::memory_order_relaxed);
+        updateThreshold();
+    }
+}
+
+void Logger::updateThreshold()
+{
+    int threshold = m_logLevel.load(std::memory_order_relaxed);
+    bool overrides = false;
+    size_t count = g_moduleOverrideCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int level = g_moduleOverrides[i].level.load(std::memory_order_relaxed);
+        if (level != kInheritLevel)
+        {
+            overrides = true;
+            threshold = std::min(threshold, level);
+        }
+    }
+    g_logModuleOverrides.store(overrides, std::memory_order_relaxed);
+    g_logThreshold.store(threshold, std::memory_order_relaxed);
+}
+
+bool Logger::moduleEnabled(LogLevel level, SourceFile file)
+{
+    // 模块名是文件名去掉扩展名
+    const char* dot = static_cast<const char*>(memchr(file.data(), '.', file.size()));
+    size_t length = dot ? static_cast<size_t>(dot - file.data()) : file.size();
+    ModuleOverride* module = findModule(file.data(), length);
+    if (module != nullptr)
+    {
+        int moduleLevel = module->level.load(std::memory_order_relaxed);
+        if (moduleLevel != kInheritLevel)
+        {
+            return level >= moduleLevel;
+        }
+    }
+    return level >= getInstance().logLevel();
+}
+
+void Logger::setOutput(OutputFunc output, FlushFunc flush)
+{
+    m_output = std::move(output);
+    m_flush = std::move(flush);
+}
+
+void Logger::flush()
+{
+    if (m_flush)
+    {
+        m_flush();
+        return;
+    }
+    // 内置写线程：等它把已有的消息写完 (最多等 kFlushTimeoutMs)
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(kFlushTimeoutMs);
+    QueueMode mode = m_queueMode.load(std::memory_order_acquire);
+    if (mode != QueueMode::kThreadRings)
+    {
+        // 队列是 FIFO：放一个标记消息，写线程处理到它时之前的消息都已写出
+        uint64_t marker = pushMarker(mode);
+        while (m_markersDone.load() < marker && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        fflush(stdout);
+        return;
+    }
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        bool empty = true;
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            for (const auto& ring : m_rings)
+            {
+                if (!ring->empty())
+                {
+                    empty = false;
+                    break;
+                }
+            }
+        }
+        if (empty)
+        {
+            break;
+        }
+        wakeWriter();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    fflush(stdout);
 }
 
 void Logger::log(const std::string& msg)
 {
-    m_logQueue.Push(msg);
+    log(msg.data(), msg.size());
+}
+
+void Logger::log(const char* msg, size_t len)
+{
+    if (m_output)
+    {
+        m_output(msg, len);
+        return;
+    }
+    QueueMode mode = m_queueMode.load(std::memory_order_acquire);
+    if (mode == QueueMode::kThreadRings)
+    {
+        appendToRing(msg, len);
+        return;
+    }
+    std::string message(msg, len);
+    bool lost = mode == QueueMode::kLockQueue ? !pushWithPolicy(m_logQueue, std::move(message))
+                                              : !pushWithPolicy(*m_mpmcQueue, std::move(message));
+    if (lost)
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
-// === LogStream 的实现 (完全保持不变) ===
-LogStream::LogStream(const char* file, int line, LogLevel level)
+// 按溢出策略放入队列，返回这条消息是否放进去了 (kDropOldest 丢掉的是别的消息)
+template<typename Queue>
+bool Logger::pushWithPolicy(Queue& queue, std::string&& message)
+{
+    switch (m_overflowPolicy.load(std::memory_order_relaxed))
+    {
+    case OverflowPolicy::kBlock:
+        return queue.PushFor(std::move(message),
+                             std::chrono::milliseconds(m_blockTimeoutMs.load(std::memory_order_relaxed)));
+    case OverflowPolicy::kDropNewest:
+        return queue.TryPush(std::move(message));
+    case OverflowPolicy::kDropOldest:
+        if (queue.PushDropOldest(std::move(message)))
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+    return true;
+}
+
+void Logger::setOverflowPolicy(OverflowPolicy policy, int blockTimeoutMs)
+{
+    m_blockTimeoutMs.store(blockTimeoutMs, std::memory_order_relaxed);
+    m_overflowPolicy.store(policy, std::memory_order_relaxed);
+}
+
+void Logger::setQueueCapacity(size_t messages)
+{
+    m_logQueue.setCapacity(messages);
+    m_queueCapacity = messages > 0 ? messages : kDefaultQueueCapacity;
+}
+
+// === LogStream 的实现 ===
+namespace
+{
+
+const char kDigits[] = "9876543210123456789";
+const char* const kZero = kDigits + 9; // 指向 '0'，负数的余数也能直接查表
+const char kDigitsHex[] = "0123456789abcdef";
+
+// 整数转十进制字符串，返回长度 (不写结尾的 '\0')
+template<typename T>
+size_t convert(char buf[], T value)
+{
+    T i = value;
+    char* p = buf;
+    do
+    {
+        int lsd = static_cast<int>(i % 10);
+        i /= 10;
+        *p++ = kZero[lsd];
+    } while (i != 0);
+
+    if (value < 0)
+    {
+        *p++ = '-';
+    }
+    std::reverse(buf, p);
+    return p - buf;
+}
+
+size_t convertHex(char buf[], uintptr_t value)
+{
+    uintptr_t i = value;
+    char* p = buf;
+    do
+    {
+        *p++ = kDigitsHex[i % 16];
+        i /= 16;
+    } while (i != 0);
+    std::reverse(buf, p);
+    return p - buf;
+}
+
+// 【新增】每个线程缓存最近一次格式化的秒，同一秒内的日志只需补上微秒
+const size_t kDateTimeLength = 19; // "YYYY-MM-DD HH:MM:SS"
+thread_local time_t t_lastSecond = -1;
+thread_local char t_dateTime[kDateTimeLength];
+
+} // namespace
+
+template<typename T>
+void LogStream::formatInteger(T v)
+{
+    if (m_buffer.avail() >= kMaxNumericSize)
+    {
+        size_t len = convert(m_buffer.current(), v);
+        m_buffer.add(len);
+    }
+}
+
+LogStream& LogStream::operator<<(short v)
+{
+    *this << static_cast<int>(v);
+    return *this;
+}
+
+LogStream& LogStream::operator<<(unsigned short v)
+{
+    *this << static_cast<unsigned int>(v);
+    return *this;
+}
+
+LogStream& LogStream::operator<<(int v)
+{
+    formatInteger(v);
+    return *this;
+}
+
+LogStream& LogStream::operator<<(unsigned int v)
+{
+    formatInteger(v);
+    return *this;
+}
+
+LogStream& LogStream::operator<<(long v)
+{
+    formatInteger(v);
+    return *this;
+}
+
+LogStream& LogStream::operator<<(unsigned long v)
+{
+    formatInteger(v);
+    return *this;
+}
+
+LogStream& LogStream::operator<<(long long v)
+{
+    formatInteger(v);
+    return *this;
+}
+
+LogStream& LogStream::operator<<(unsigned long long v)
+{
+    formatInteger(v);
+    return *this;
+}
+
+LogStream& LogStream::operator<<(const void* p)
+{
+    if (m_buffer.avail() >= kMaxNumericSize)
+    {
+        char* buf = m_buffer.current();
+        buf[0] = '0';
+        buf[1] = 'x';
+        size_t len = convertHex(buf + 2, reinterpret_cast<uintptr_t>(p));
+        m_buffer.add(len + 2);
+    }
+    return *this;
+}
+
+LogStream& LogStream::operator<<(double v)
+{
+    if (m_buffer.avail() >= kMaxNumericSize)
+    {
+        // 与原来 ostream 的默认输出 (%g，6 位有效数字) 一致，但不依赖 locale，也不解析格式串
+        char* buf = m_buffer.current();
+        std::to_chars_result result =
+            std::to_chars(buf, buf + kMaxNumericSize, v, std::chars_format::general, 6);
+        m_buffer.add(result.ptr - buf);
+    }
+    return *this;
+}
+
+void LogStream::formatTime()
+{
+    int64_t microSeconds = Timestamp::now().microSecondsSinceEpoch();
+    time_t seconds = static_cast<time_t>(microSeconds / Timestamp::kMicroSecondsPerSecond);
+    int micros = static_cast<int>(microSeconds % Timestamp::kMicroSecondsPerSecond);
+    if (seconds != t_lastSecond)
+    {
+        t_lastSecond = seconds;
+        tm tm_time;
+        localtime_r(&seconds, &tm_time);
+        // 与下面的微秒一样按位填数字，不解析格式串，也不用为 snprintf 按 int 最大宽度预留空间
+        const int fields[6] = {tm_time.tm_year + 1900, tm_time.tm_mon + 1, tm_time.tm_mday,
+                               tm_time.tm_hour, tm_time.tm_min, tm_time.tm_sec};
+        const char separators[6] = {'-', '-', ' ', ':', ':', '\0'};
+        char* p = t_dateTime;
+        for (int f = 0; f < 6; ++f)
+        {
+            int width = f == 0 ? 4 : 2;
+            int value = fields[f];
+            for (int i = width - 1; i >= 0; --i)
+            {
+                p[i] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+            p += width;
+            if (separators[f] != '\0')
+            {
+                *p++ = separators[f];
+            }
+        }
+    }
+    m_buffer.append(t_dateTime, kDateTimeLength);
+
+    // 固定 6 位微秒，从低位往高位填
+    char frac[8] = {'.', '0', '0', '0', '0', '0', '0', ' '};
+    for (int i = 6; i >= 1 && micros != 0; --i)
+    {
+        frac[i] = static_cast<char>('0' + micros % 10);
+        micros /= 10;
+    }
+    m_buffer.append(frac, sizeof frac);
+}
+
+bool LogRateLimiter::shouldLog(int maxPerSecond)
+{
+    int64_t now = MonoTime::now().nanoSeconds();
+    int64_t windowStart = m_windowStart.load(std::memory_order_relaxed);
+    if (now - windowStart >= MonoTime::kNanoSecondsPerSecond &&
+        m_windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed))
+    {
+        // 只有开启新窗口的线程清零；与其它线程的计数交错时最多多放行几条
+        m_count.store(0, std::memory_order_relaxed);
+    }
+    return m_count.fetch_add(1, std::memory_order_relaxed) < maxPerSecond;
+}
+
+LogStream::LogStream(SourceFile file, int line, LogLevel level)
     :m_level(level)
 {
-    m_buffer << Timestamp::now().toString() << " ";
+    // 【修改】不再每条日志调用 Timestamp::toString (localtime_r + snprintf + std::string)
+    formatTime();
     switch (level)
     {
-    case INFO:  m_buffer << "[INFO]";  break;
-    case ERROR: m_buffer << "[ERROR]"; break;
-    case FATAL: m_buffer << "[FATAL]"; break;
-    case DEBUG: m_buffer << "[DEBUG]"; break;
+    case INFO:  *this << "[INFO]";  break;
+    case ERROR: *this << "[ERROR]"; break;
+    case FATAL: *this << "[FATAL]"; break;
+    case DEBUG: *this << "[DEBUG]"; break;
     }
-    m_buffer << " " << file << ":" << line << " ";
+    m_buffer.append(" ", 1);
+    m_buffer.append(file.data(), file.size());
+    *this << ':' << line << ' ';
 }
 
 LogStream::~LogStream()
 {
-    m_buffer << "\n";
-    Logger::getInstance().log(m_buffer.str());
+    if (m_buffer.avail() > 1)
+    {
+        m_buffer.append("\n", 1);
+    }
+    else
+    {
+        m_buffer.current()[-1] = '\n'; // 缓冲区已满，用换行覆盖最后一个字符
+    }
+    Logger::getInstance().log(m_buffer.data(), m_buffer.length());
     
     // 【新增】如果是 FATAL 级别，就终止程序
     if (m_level == FATAL)
     {
+        Logger::getInstance().flush(); // 先让异步后端把已有日志写完
         abort(); // abort() 会立刻终止程序
     }
 }
@@ -5,11 +5,23 @@
 
 #include "Timestamp.h"
 #include "LockQueue.h"
+#include "MpmcQueue.h"
+#include "LogBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
-#include <sstream>
+#include <type_traits>
+#include <vector>
 #include <functional>
 
+class LogRing;
+
 enum LogLevel {
     DEBUG, // 0
     INFO,  // 1
@@ -17,16 +29,118 @@ enum LogLevel {
     FATAL, // 3
 };
 
+// 【新增】编译期最低级别：低于它的 LOG_* 语句条件恒为假，整条语句被编译器删除。
+// 可用 -DMYMUDUO_MIN_LOG_LEVEL=N (CMake 同名缓存变量) 指定；默认 Release (NDEBUG) 去掉 LOG_DEBUG
+#ifndef MYMUDUO_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define MYMUDUO_MIN_LOG_LEVEL 1
+#else
+#define MYMUDUO_MIN_LOG_LEVEL 0
+#endif
+#endif
+
+// 【新增】运行期级别检查只读这两个全局变量 (relaxed)，不经过 Logger::getInstance() 的局部静态变量检查
+extern std::atomic<int> g_logThreshold;        // 全局级别与所有模块级覆盖中最低的那个
+extern std::atomic<bool> g_logModuleOverrides; // 是否设置了模块级覆盖
+
+// 【新增】编译期求出 __FILE__ 中文件名 (最后一个 '/' 之后) 的起始位置
+constexpr size_t sourceBasenameOffset(const char* path)
+{
+    size_t offset = 0;
+    for (size_t i = 0; path[i] != '\0'; ++i)
+    {
+        if (path[i] == '/')
+        {
+            offset = i + 1;
+        }
+    }
+    return offset;
+}
+
+// 【新增】源文件名：只保留 basename，长度在编译期已知，打印时不需要 strlen
+class SourceFile
+{
+public:
+    template<size_t N>
+    constexpr SourceFile(const char (&path)[N], size_t offset)
+        : m_data(path + offset),
+          m_size(N - 1 - offset)
+    {}
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+};
+
+// 通过 integral_constant 强制偏移在编译期计算，而不是每条日志扫描一遍路径
+#define LOG_SOURCE_FILE \
+    SourceFile(__FILE__, std::integral_constant<size_t, sourceBasenameOffset(__FILE__)>::value)
+
 // 日志类 (单例)
 class Logger
 {
 public:
+    // 【新增】自定义输出：设置后日志在调用线程直接交给 output (例如 AsyncLogging::append)，
+    // 不再经过内置的队列和写线程；flush 在 LOG_FATAL 终止程序前调用
+    using OutputFunc = std::function<void(const char* msg, size_t len)>;
+    using FlushFunc = std::function<void()>;
+
+    // 【新增】内置写线程的队列实现 (未设置 output 时使用)
+    enum class QueueMode
+    {
+        kThreadRings, // 默认：每个线程一个无锁环，写线程成批取走，生产者之间没有竞争
+        kLockQueue,   // 原来的实现：所有线程共用一个加锁队列，每条消息一次 notify
+        kMpmcQueue,   // 所有线程共用一个有界无锁环形队列，写线程空闲时才需要 futex 唤醒
+    };
+
+    // 【新增】内置写线程跟不上、队列满时的处理方式
+    enum class OverflowPolicy
+    {
+        kBlock,      // 默认：等待写线程腾出空间，最多等 blockTimeoutMs，超时丢弃这条
+        kDropNewest, // 立即丢弃这条，调用线程不等待
+        kDropOldest, // 丢弃队列中最旧的一条；线程环只能由写线程释放空间，环模式下按 kDropNewest 处理
+    };
+
     static Logger& getInstance();
     void setLogLevel(LogLevel level);
 
-    int logLevel() const { return m_logLevel; }
+    int logLevel() const { return m_logLevel.load(std::memory_order_relaxed); }
+
+    // 【新增】模块级覆盖：模块名是源文件名去掉扩展名 (例如 "TcpConnection")，
+    // 该文件中的日志改用 level 判断，不受全局级别影响；最多 32 个模块
+    void setModuleLevel(const std::string& module, LogLevel level);
+    // 恢复为跟随全局级别
+    void clearModuleLevel(const std::string& module);
+    // 存在模块级覆盖时由 logEnabled 调用：按 file 所属模块的级别判断
+    static bool moduleEnabled(LogLevel level, SourceFile file);
+
+    // 应在启动时、其它线程开始打日志之前调用
+    void setOutput(OutputFunc output, FlushFunc flush = FlushFunc());
+    // 调用 flush 回调；未设置 output 时等待内置写线程把已有的消息写到 stdout
+    void flush();
+
+    // 应在启动时、开始打日志之前调用；切换前已排队的消息可能延迟到退出时才输出
+    void setQueueMode(QueueMode mode);
+
+    // 【新增】可以随时调用；blockTimeoutMs 只对 kBlock 有效
+    void setOverflowPolicy(OverflowPolicy policy, int blockTimeoutMs = kDefaultBlockTimeoutMs);
+    // LockQueue 模式下队列最多容纳的消息条数 (环模式的上限是每线程 kThreadRingSize 字节)；
+    // MpmcQueue 在第一次切换到 kMpmcQueue 时按当时的值创建，之后不再改变
+    void setQueueCapacity(size_t messages);
+    // 因队列满而丢弃的消息总数 (包括二进制日志丢弃的记录)；写线程也会把新增的丢弃数写进日志
+    uint64_t droppedMessages() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // 【新增】BinaryLogger 的环满时按同一策略处理，丢弃的记录计入 droppedMessages()
+    OverflowPolicy overflowPolicy() const { return m_overflowPolicy.load(std::memory_order_relaxed); }
+    int blockTimeoutMs() const { return m_blockTimeoutMs.load(std::memory_order_relaxed); }
+    void countDropped() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
 
     void log(const std::string& msg);
+    // 【新增】LogStream 使用：设置了 output 时直接传递，不构造 std::string
+    void log(const char* msg, size_t len);
     
 private:
     Logger();
@@ -34,46 +148,256 @@ private:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
-    LogLevel m_logLevel;
+    // 每个线程的环大小，16 个 IO 线程共约 4MB
+    static constexpr size_t kThreadRingSize = 256 * 1024;
+    static const size_t kDefaultQueueCapacity = 64 * 1024;
+    static const int kDefaultBlockTimeoutMs = 1000;
+
+    void writerThreadFunc();
+    LogRing* threadRing();
+    void appendToRing(const char* msg, size_t len);
+    // 把所有线程环里的消息写到 stdout，返回写出的条数
+    size_t drainRings();
+    void wakeWriter();
+    // 向 mode 对应的队列放入一个标记消息，返回它的序号
+    uint64_t pushMarker(QueueMode mode);
+    // 写线程调用：取走 queue 中的消息写到 stdout；队列已关闭且为空时返回 false
+    template<typename Queue>
+    bool writeQueued(Queue& queue, std::vector<std::string>& batch);
+    static void writeOut(const char* msg, size_t len);
+    template<typename Queue>
+    bool pushWithPolicy(Queue& queue, std::string&& message);
+    // 写线程调用：丢弃数比上次报告时增加了就写一条说明
+    void reportDropped();
+    // 重新计算 g_logThreshold 和 g_logModuleOverrides，调用者持有 m_moduleMutex
+    void updateThreshold();
+
+    std::atomic<int> m_logLevel;
+    std::mutex m_moduleMutex;                      // 串行化 setModuleLevel / clearModuleLevel
+    OutputFunc m_output;
+    FlushFunc m_flush;
+    std::atomic<QueueMode> m_queueMode;
     LockQueue<std::string> m_logQueue;
+    std::unique_ptr<MpmcQueue<std::string>> m_mpmcQueue; // 第一次切换到 kMpmcQueue 时创建
+    size_t m_queueCapacity;
+    std::atomic<uint64_t> m_markersSent;
+    std::atomic<uint64_t> m_markersDone;           // 写线程已处理的标记数
+    std::atomic<OverflowPolicy> m_overflowPolicy;
+    std::atomic<int> m_blockTimeoutMs;
+    std::atomic<uint64_t> m_dropped;
+    uint64_t m_droppedReported;                    // 写线程私有
+
+    std::mutex m_ringsMutex;                       // 保护 m_rings (线程首次打日志时注册)
+    std::vector<std::shared_ptr<LogRing>> m_rings;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCond;
+    std::atomic<bool> m_writerSleeping;            // 写线程准备睡眠，生产者需要唤醒它
+    std::atomic<bool> m_exiting;
     std::thread m_writerThread;
     // std::atomic<bool> m_exit_flag; // 【移除】不再需要这个退出标志
 };
 
-// LogStream 和 日志宏 (完全保持不变)
+/**
+ * @brief 一条日志消息的格式化流。
+ * 【修改】不再包装 std::ostringstream：内容直接写进栈上的定长缓冲区 (kSmallBuffer 字节)，
+ * 整数、指针、浮点数手写格式化，不构造 locale 相关的流、不分配内存，析构时整段交给 Logger。
+ * 缓冲区快满时字符串截断到剩余空间，数字 (需要 kMaxNumericSize 字节) 放不下就整个丢弃；
+ * 结尾总有换行 (必要时覆盖最后一个字符)。
+ * 没有专门重载的类和枚举类型 (例如只提供了 ostream 插入运算符的用户类型) 经 std::ostringstream 格式化。
+ */
 class LogStream
 {
 public:
-    LogStream(const char* file, int line, LogLevel level);
+    using Buffer = FixedBuffer<kSmallBuffer>;
+
+    LogStream(SourceFile file, int line, LogLevel level);
     ~LogStream();
 
-    template<typename T>
-    LogStream& operator<<(const T& value)
+    LogStream& operator<<(bool v)
+    {
+        m_buffer.append(v ? "1" : "0", 1);
+        return *this;
+    }
+
+    LogStream& operator<<(short);
+    LogStream& operator<<(unsigned short);
+    LogStream& operator<<(int);
+    LogStream& operator<<(unsigned int);
+    LogStream& operator<<(long);
+    LogStream& operator<<(unsigned long);
+    LogStream& operator<<(long long);
+    LogStream& operator<<(unsigned long long);
+
+    LogStream& operator<<(const void*);
+
+    LogStream& operator<<(float v)
+    {
+        *this << static_cast<double>(v);
+        return *this;
+    }
+    LogStream& operator<<(double);
+
+    LogStream& operator<<(char v)
+    {
+        m_buffer.append(&v, 1);
+        return *this;
+    }
+
+    LogStream& operator<<(const char* str)
     {
-        m_buffer << value;
+        if (str)
+        {
+            appendTruncated(str, strlen(str));
+        }
+        else
+        {
+            appendTruncated("(null)", 6);
+        }
         return *this;
     }
 
+    LogStream& operator<<(const unsigned char* str)
+    {
+        return operator<<(reinterpret_cast<const char*>(str));
+    }
+
+    LogStream& operator<<(std::string_view v)
+    {
+        appendTruncated(v.data(), v.size());
+        return *this;
+    }
+
+    LogStream& operator<<(const std::string& v)
+    {
+        appendTruncated(v.data(), v.size());
+        return *this;
+    }
+
+    // 【新增】兜底：类和枚举类型只要能写进 std::ostream 就能写进日志 (走 ostringstream，比上面的重载慢)
+    template<typename T,
+             typename = std::enable_if_t<std::is_class<T>::value || std::is_enum<T>::value>,
+             typename = decltype(std::declval<std::ostream&>() << std::declval<const T&>())>
+    LogStream& operator<<(const T& v)
+    {
+        std::ostringstream os;
+        os << v;
+        const std::string str = os.str();
+        appendTruncated(str.data(), str.size());
+        return *this;
+    }
+
+    const Buffer& buffer() const { return m_buffer; }
+
 private:
-    std::ostringstream m_buffer;
+    // 放不下时截断到剩余空间 (留一个字节，FixedBuffer::append 要求严格小于 avail())
+    void appendTruncated(const char* str, size_t len)
+    {
+        size_t room = static_cast<size_t>(m_buffer.avail() - 1);
+        m_buffer.append(str, len < room ? len : room);
+    }
+
+    template<typename T>
+    void formatInteger(T);
+    // 写入 "YYYY-MM-DD HH:MM:SS.uuuuuu "，日期时间部分按线程缓存，每秒只格式化一次
+    void formatTime();
+
+    // 单个数字最长的输出长度，剩余空间不足时整段丢弃
+    static const int kMaxNumericSize = 48;
+
+    Buffer m_buffer;
     LogLevel m_level;// 【新增】记录当前消息的级别
 };
 
-// 【修改后】增加判断逻辑
+// 【新增】LOG_* 的级别判断：编译期常量比较 + 一次 relaxed 原子读；
+// 只有设置了模块级覆盖、且级别不低于阈值时才去查模块表
+inline bool logEnabled(LogLevel level, SourceFile file)
+{
+    return level >= MYMUDUO_MIN_LOG_LEVEL &&
+           level >= g_logThreshold.load(std::memory_order_relaxed) &&
+           (!g_logModuleOverrides.load(std::memory_order_relaxed) || Logger::moduleEnabled(level, file));
+}
+
+// 【修改】不再调用 Logger::getInstance() 读级别
 #define LOG_INFO \
-    if (Logger::getInstance().logLevel() <= INFO) \
-        LogStream(__FILE__, __LINE__, INFO)
+    if (logEnabled(INFO, LOG_SOURCE_FILE)) \
+        LogStream(LOG_SOURCE_FILE, __LINE__, INFO)
 
 #define LOG_DEBUG \
-    if (Logger::getInstance().logLevel() <= DEBUG) \
-        LogStream(__FILE__, __LINE__, DEBUG)
+    if (logEnabled(DEBUG, LOG_SOURCE_FILE)) \
+        LogStream(LOG_SOURCE_FILE, __LINE__, DEBUG)
 
 #define LOG_ERROR \
-    if (Logger::getInstance().logLevel() <= ERROR) \
-        LogStream(__FILE__, __LINE__, ERROR)
+    if (logEnabled(ERROR, LOG_SOURCE_FILE)) \
+        LogStream(LOG_SOURCE_FILE, __LINE__, ERROR)
 
 #define LOG_FATAL \
-    if (Logger::getInstance().logLevel() <= FATAL) \
-        LogStream(__FILE__, __LINE__, FATAL)
+    if (logEnabled(FATAL, LOG_SOURCE_FILE)) \
+        LogStream(LOG_SOURCE_FILE, __LINE__, FATAL)
+
+// 【新增】热点错误路径的限流 (例如 fd 耗尽时每次 accept 都失败)，状态按调用点保存，常量初始化
+class LogEveryN
+{
+public:
+    constexpr LogEveryN() : m_count(0) {}
+
+    // 第 1、n+1、2n+1 ... 次返回 true
+    bool shouldLog(uint64_t n)
+    {
+        uint64_t count = m_count.fetch_add(1, std::memory_order_relaxed);
+        return n <= 1 || count % n == 0;
+    }
+
+private:
+    std::atomic<uint64_t> m_count;
+};
+
+class LogRateLimiter
+{
+public:
+    constexpr LogRateLimiter() : m_windowStart(0), m_count(0) {}
+
+    // 每个 1 秒的窗口内只有前 maxPerSecond 次返回 true
+    bool shouldLog(int maxPerSecond);
+
+private:
+    std::atomic<int64_t> m_windowStart; // MonoTime 纳秒
+    std::atomic<int> m_count;
+};
+
+// 每个展开点一个 lambda，因而一份独立的静态状态
+#define LOG_CALLSITE_STATE(Type) \
+    ([]() -> Type& { static Type state; return state; }())
+
+// 用法: LOG_EVERY_N(ERROR, 100) << "accept err:" << errno;
+#define LOG_EVERY_N(level, n) \
+    if (logEnabled(level, LOG_SOURCE_FILE) && LOG_CALLSITE_STATE(LogEveryN).shouldLog(n)) \
+        LogStream(LOG_SOURCE_FILE, __LINE__, level)
+
+// 用法: LOG_RATE_LIMITED(ERROR, 10) << "accept err:" << errno;
+#define LOG_RATE_LIMITED(level, maxPerSecond) \
+    if (logEnabled(level, LOG_SOURCE_FILE) && LOG_CALLSITE_STATE(LogRateLimiter).shouldLog(maxPerSecond)) \
+        LogStream(LOG_SOURCE_FILE, __LINE__, level)
+
+// 【新增】编译期开关：LOG_* 改为记录二进制日志，由 binlog_decode 离线还原成文本
+#ifdef MYMUDUO_BINARY_LOG
+#include "BinaryLog.h"
+
+#undef LOG_INFO
+#undef LOG_DEBUG
+#undef LOG_ERROR
+#undef LOG_FATAL
+#undef LOG_EVERY_N
+#undef LOG_RATE_LIMITED
+#define LOG_INFO BINLOG_INFO
+#define LOG_DEBUG BINLOG_DEBUG
+#define LOG_ERROR BINLOG_ERROR
+#define LOG_FATAL BINLOG_FATAL
+#define LOG_EVERY_N(level, n) \
+    if (logEnabled(level, LOG_SOURCE_FILE) && LOG_CALLSITE_STATE(LogEveryN).shouldLog(n)) \
+        BinaryLogStream(BINLOG_SITE(level))
+#define LOG_RATE_LIMITED(level, maxPerSecond) \
+    if (logEnabled(level, LOG_SOURCE_FILE) && LOG_CALLSITE_STATE(LogRateLimiter).shouldLog(maxPerSecond)) \
+        BinaryLogStream(BINLOG_SITE(level))
+#endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+// base/MonoTime.cpp
+
+#include "MonoTime.h"
+
+#include <atomic>
+#include <ctime>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define MONOTIME_HAS_TSC 1
+#endif
+
+namespace
+{
+
+int64_t clockMonotonicNs()
+{
+    struct timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * MonoTime::kNanoSecondsPerSecond + ts.tv_nsec;
+}
+
+#ifdef MONOTIME_HAS_TSC
+
+// ns = baseNs + ((tsc - baseTsc) * mult) >> kShift
+// 用 128 位乘法，差值再大也不会溢出
+const int kShift = 32;
+
+struct TscCalibration
+{
+    int64_t baseNs;
+    uint64_t baseTsc;
+    uint64_t mult;
+};
+
+TscCalibration g_tsc;
+std::atomic<bool> g_useTsc(false);
+
+bool hasInvariantTsc()
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+    {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+}
+
+// 同时读取 TSC 和 CLOCK_MONOTONIC，取两次 rdtsc 间隔最短的一次以减小误差
+void sample(uint64_t* tsc, int64_t* ns)
+{
+    uint64_t bestWidth = UINT64_MAX;
+    for (int i = 0; i < 5; ++i)
+    {
+        uint64_t before = __rdtsc();
+        int64_t clockNs = clockMonotonicNs();
+        uint64_t after = __rdtsc();
+        if (after - before < bestWidth)
+        {
+            bestWidth = after - before;
+            *tsc = before + (after - before) / 2;
+            *ns = clockNs;
+        }
+    }
+}
+
+#endif
+
+} // namespace
+
+MonoTime MonoTime::now()
+{
+#ifdef MONOTIME_HAS_TSC
+    if (g_useTsc.load(std::memory_order_acquire))
+    {
+        uint64_t delta = __rdtsc() - g_tsc.baseTsc;
+        uint64_t ns = static_cast<uint64_t>((static_cast<unsigned __int128>(delta) * g_tsc.mult) >> kShift);
+        return MonoTime(g_tsc.baseNs + static_cast<int64_t>(ns));
+    }
+#endif
+    return MonoTime(clockMonotonicNs());
+}
+
+bool MonoTime::enableTsc()
+{
+#ifdef MONOTIME_HAS_TSC
+    if (!hasInvariantTsc())
+    {
+        return false;
+    }
+
+    // 用 20ms 的窗口校准频率
+    uint64_t tsc0 = 0, tsc1 = 0;
+    int64_t ns0 = 0, ns1 = 0;
+    sample(&tsc0, &ns0);
+    struct timespec interval = {0, 20 * 1000 * 1000};
+    ::nanosleep(&interval, nullptr);
+    sample(&tsc1, &ns1);
+    if (tsc1 <= tsc0 || ns1 <= ns0)
+    {
+        return false;
+    }
+
+    g_tsc.baseNs = ns1;
+    g_tsc.baseTsc = tsc1;
+    g_tsc.mult = static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(ns1 - ns0) << kShift) / (tsc1 - tsc0));
+    g_useTsc.store(true, std::memory_order_release);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool MonoTime::tscEnabled()
+{
+#ifdef MONOTIME_HAS_TSC
+    return g_useTsc.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+}
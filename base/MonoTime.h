@@ -0,0 +1,62 @@
+// base/MonoTime.h
+
+#ifndef MONOTIME_H
+#define MONOTIME_H
+
+#include <cstdint>
+
+/**
+ * @brief 单调时钟上的时间点 (纳秒)，用于定时器和延迟统计。
+ * 与 Timestamp 不同，它不受系统时间被修改 (NTP 跳变、手动改时间) 的影响，
+ * 数值本身没有日历含义，只能相互比较或相减；日志中的时间仍然使用 Timestamp。
+ *
+ * 默认用 clock_gettime(CLOCK_MONOTONIC) 读取 (vDSO，无系统调用)。
+ * 在支持 invariant TSC 的 x86 上可以调用 enableTsc()：启动时用 CLOCK_MONOTONIC 校准一次，
+ * 之后 now() 只执行 rdtsc 加一次乘法和移位，结果与 CLOCK_MONOTONIC 处在同一时间轴上。
+ */
+class MonoTime
+{
+public:
+    MonoTime()
+        : m_nanoSeconds(0)
+    {}
+
+    explicit MonoTime(int64_t nanoSeconds)
+        : m_nanoSeconds(nanoSeconds)
+    {}
+
+    static MonoTime now();
+
+    // 校准并启用 rdtsc 快速路径，应在启动时、其它线程读取时钟之前调用
+    // CPU 不支持 invariant TSC 或非 x86 平台返回 false，继续使用 clock_gettime
+    static bool enableTsc();
+    static bool tscEnabled();
+
+    int64_t nanoSeconds() const { return m_nanoSeconds; }
+    int64_t microSeconds() const { return m_nanoSeconds / kNanoSecondsPerMicroSecond; }
+
+    bool valid() const { return m_nanoSeconds > 0; }
+
+    static const int64_t kNanoSecondsPerMicroSecond = 1000;
+    static const int64_t kNanoSecondsPerSecond = 1000 * 1000 * 1000;
+
+    bool operator<(const MonoTime& rhs) const { return m_nanoSeconds < rhs.m_nanoSeconds; }
+    bool operator==(const MonoTime& rhs) const { return m_nanoSeconds == rhs.m_nanoSeconds; }
+
+private:
+    int64_t m_nanoSeconds;
+};
+
+inline MonoTime addTime(MonoTime time, double seconds)
+{
+    int64_t delta = static_cast<int64_t>(seconds * MonoTime::kNanoSecondsPerSecond);
+    return MonoTime(time.nanoSeconds() + delta);
+}
+
+// 两个时间点之间的微秒数 (high - low)
+inline int64_t microSecondsBetween(MonoTime high, MonoTime low)
+{
+    return (high.nanoSeconds() - low.nanoSeconds()) / MonoTime::kNanoSecondsPerMicroSecond;
+}
+
+#endif
@@ -0,0 +1,431 @@
+// base/MpmcQueue.h
+
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+
+#include "noncopyable.h"
+#include "Futex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 有界多生产者/多消费者无锁环形队列 (Dmitry Vyukov 的算法)，可替代 LockQueue<T>。
+ * - 每个槽位带一个序号：等于 pos 表示可写，等于 pos + 1 表示可读；
+ *   生产者/消费者各自 CAS 抢占 tail/head 上的位置，抢到后独占该槽位，没有锁；
+ * - head / tail 各占一个缓存行；容量向上取整为 2 的幂，构造后不能改变；
+ * - TryPush / TryPop 从不阻塞；Push / Pop / PopBatch 等阻塞版本先自旋几轮，
+ *   仍然满/空才在 futex 上休眠，对端只有在有人休眠时才执行唤醒的系统调用。
+ * 接口与 LockQueue 一致 (Push / TryPush / PushFor / PushDropOldest / Pop / TryPop / PopBatch / PopAll / Shutdown)，
+ * 二者可以互换作为 ThreadPool、Logger 的队列。
+ */
+template<typename T>
+class MpmcQueue : noncopyable
+{
+public:
+    explicit MpmcQueue(size_t capacity)
+        : m_mask(roundUpPowerOfTwo(capacity) - 1),
+          m_cells(new Cell[m_mask + 1]),
+          m_head(0),
+          m_tail(0),
+          m_notEmptyEpoch(0),
+          m_popWaiters(0),
+          m_notFullEpoch(0),
+          m_pushWaiters(0),
+          m_shutdown(false)
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcQueue()
+    {
+        while (dequeue())
+        {
+        }
+    }
+
+    // 满或已关闭时返回 false，右值参数保持原样
+    bool TryPush(const T& data) { return tryPushImpl(data); }
+    bool TryPush(T&& data) { return tryPushImpl(std::move(data)); }
+
+    // 满了就等待空位；关闭后放入的元素被丢弃
+    void Push(const T& data) { pushImpl(data); }
+    void Push(T&& data) { pushImpl(std::move(data)); }
+
+    template<typename Rep, typename Period>
+    bool PushFor(const T& data, std::chrono::duration<Rep, Period> timeout)
+    {
+        return pushForImpl(data, timeout);
+    }
+
+    template<typename Rep, typename Period>
+    bool PushFor(T&& data, std::chrono::duration<Rep, Period> timeout)
+    {
+        return pushForImpl(std::move(data), timeout);
+    }
+
+    // 满了就替消费者取走最旧的一个，返回是否丢弃了旧元素
+    bool PushDropOldest(const T& data) { return pushDropOldestImpl(data); }
+    bool PushDropOldest(T&& data) { return pushDropOldestImpl(std::move(data)); }
+
+    std::optional<T> TryPop()
+    {
+        std::optional<T> data = dequeue();
+        if (data)
+        {
+            notifyNotFull();
+        }
+        return data;
+    }
+
+    // 等到有元素；队列已关闭且为空时返回 nullopt
+    std::optional<T> Pop()
+    {
+        // hasItems 为真时元素可能还在写入，或者被别的消费者抢先取走，所以要循环
+        while (waitNotEmpty())
+        {
+            if (std::optional<T> data = TryPop())
+            {
+                return data;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // 等到至少有一个元素，取走最多 maxItems 个追加到 out；队列已关闭且为空时返回 false
+    bool PopBatch(std::vector<T>& out, size_t maxItems)
+    {
+        return popBatchUntil(out, maxItems, true, nullptr);
+    }
+
+    // 同 PopBatch，但最多等 timeout；超时也返回 false
+    template<typename Rep, typename Period>
+    bool PopBatchFor(std::vector<T>& out, size_t maxItems, std::chrono::duration<Rep, Period> timeout)
+    {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+        return popBatchUntil(out, maxItems, true, &deadline);
+    }
+
+    // 同 PopBatch，但取走全部，不与其它等待的消费者平分
+    bool PopAll(std::vector<T>& out)
+    {
+        return popBatchUntil(out, static_cast<size_t>(-1), false, nullptr);
+    }
+
+    // 唤醒所有等待者；之后 Push 被丢弃，Pop 取完剩余元素后返回空
+    void Shutdown()
+    {
+        m_shutdown.store(true);
+        m_notEmptyEpoch.fetch_add(1);
+        futexWake(&m_notEmptyEpoch, INT_MAX);
+        m_notFullEpoch.fetch_add(1);
+        futexWake(&m_notFullEpoch, INT_MAX);
+    }
+
+    // 近似值
+    size_t Size() const
+    {
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        size_t head = m_head.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    // 休眠前不断重试的轮数
+    static const int kSpinRounds = 64;
+    static const size_t kCacheLineSize = 64;
+
+    template<typename U>
+    bool enqueue(U&& data)
+    {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &m_cells[pos & m_mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 满：这个槽位上一轮的元素还没被取走
+            }
+            else
+            {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->storage) T(std::forward<U>(data));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> dequeue()
+    {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &m_cells[pos & m_mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return std::nullopt; // 空：这个槽位还没有写入
+            }
+            else
+            {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+        std::optional<T> data(std::move(*cell->value()));
+        cell->value()->~T();
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return data;
+    }
+
+    // 与 park 中 "先登记等待者再复查条件" 配对：要么等待者复查时看到变化，要么这里看到等待者
+    void notify(std::atomic<uint32_t>& epoch, std::atomic<int>& waiters, int count)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0)
+        {
+            epoch.fetch_add(1, std::memory_order_release);
+            futexWake(&epoch, count);
+        }
+    }
+
+    // 一次放入一个元素，叫醒一个消费者就够；批量取走可能腾出多个空位，叫醒所有生产者
+    void notifyNotEmpty() { notify(m_notEmptyEpoch, m_popWaiters, 1); }
+    void notifyNotFull() { notify(m_notFullEpoch, m_pushWaiters, INT_MAX); }
+
+    // ready() 为假时在 epoch 上休眠一次；timeout 为 nullptr 表示不限时
+    template<typename Ready>
+    void park(std::atomic<uint32_t>& epoch, std::atomic<int>& waiters, Ready ready, const struct timespec* timeout)
+    {
+        uint32_t observed = epoch.load(std::memory_order_acquire);
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ready() && !m_shutdown.load())
+        {
+            futexWait(&epoch, observed, timeout);
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool hasItems() const { return m_tail.load(std::memory_order_relaxed) != m_head.load(std::memory_order_relaxed); }
+    bool hasRoom() const { return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed) <= m_mask; }
+
+    // 等到可能有元素；已关闭且为空、或者过了 deadline (nullptr 表示不限时) 时返回 false
+    bool waitNotEmpty(const std::chrono::steady_clock::time_point* deadline = nullptr)
+    {
+        int spins = 0;
+        while (!hasItems())
+        {
+            if (m_shutdown.load())
+            {
+                return hasItems();
+            }
+            if (++spins < kSpinRounds)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            spins = 0;
+            if (deadline == nullptr)
+            {
+                park(m_notEmptyEpoch, m_popWaiters, [this] { return hasItems(); }, nullptr);
+                continue;
+            }
+            std::chrono::steady_clock::duration left = *deadline - std::chrono::steady_clock::now();
+            if (left <= std::chrono::steady_clock::duration::zero())
+            {
+                return false;
+            }
+            struct timespec ts = toTimespec(left);
+            park(m_notEmptyEpoch, m_popWaiters, [this] { return hasItems(); }, &ts);
+        }
+        return true;
+    }
+
+    bool popBatchUntil(std::vector<T>& out, size_t maxItems, bool fairShare,
+                       const std::chrono::steady_clock::time_point* deadline)
+    {
+        size_t n = 0;
+        while (n == 0)
+        {
+            if (!waitNotEmpty(deadline))
+            {
+                return false;
+            }
+            // 与仍在等待的消费者平分 (同 LockQueue)
+            size_t limit = maxItems;
+            if (fairShare)
+            {
+                size_t waiters = static_cast<size_t>(m_popWaiters.load(std::memory_order_relaxed));
+                limit = std::min(maxItems, std::max<size_t>(1, (Size() + waiters) / (waiters + 1)));
+            }
+            while (n < limit)
+            {
+                std::optional<T> data = dequeue();
+                if (!data)
+                {
+                    break;
+                }
+                out.push_back(std::move(*data));
+                ++n;
+            }
+        }
+        notifyNotFull();
+        return true;
+    }
+
+    static struct timespec toTimespec(std::chrono::steady_clock::duration duration)
+    {
+        long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        struct timespec ts = {static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)};
+        return ts;
+    }
+
+    template<typename U>
+    bool tryPushImpl(U&& data)
+    {
+        if (m_shutdown.load(std::memory_order_relaxed) || !enqueue(std::forward<U>(data)))
+        {
+            return false;
+        }
+        notifyNotEmpty();
+        return true;
+    }
+
+    template<typename U>
+    void pushImpl(U&& data)
+    {
+        int spins = 0;
+        while (!m_shutdown.load(std::memory_order_relaxed))
+        {
+            if (enqueue(std::forward<U>(data)))
+            {
+                notifyNotEmpty();
+                return;
+            }
+            if (++spins < kSpinRounds)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            spins = 0;
+            park(m_notFullEpoch, m_pushWaiters, [this] { return hasRoom(); }, nullptr);
+        }
+    }
+
+    template<typename U, typename Rep, typename Period>
+    bool pushForImpl(U&& data, std::chrono::duration<Rep, Period> timeout)
+    {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+        int spins = 0;
+        while (!m_shutdown.load(std::memory_order_relaxed))
+        {
+            if (enqueue(std::forward<U>(data)))
+            {
+                notifyNotEmpty();
+                return true;
+            }
+            std::chrono::steady_clock::duration left = deadline - std::chrono::steady_clock::now();
+            if (left <= std::chrono::steady_clock::duration::zero())
+            {
+                return false;
+            }
+            if (++spins < kSpinRounds)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            spins = 0;
+            struct timespec ts = toTimespec(left);
+            park(m_notFullEpoch, m_pushWaiters, [this] { return hasRoom(); }, &ts);
+        }
+        return false;
+    }
+
+    template<typename U>
+    bool pushDropOldestImpl(U&& data)
+    {
+        bool dropped = false;
+        while (!m_shutdown.load(std::memory_order_relaxed))
+        {
+            if (enqueue(std::forward<U>(data)))
+            {
+                notifyNotEmpty();
+                return dropped;
+            }
+            // 空出来的位置马上由自己填上，不需要唤醒等待空位的生产者
+            if (dequeue())
+            {
+                dropped = true;
+            }
+        }
+        return false;
+    }
+
+    static size_t roundUpPowerOfTwo(size_t n)
+    {
+        size_t size = 2;
+        while (size < n)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    const size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    // 消费者和生产者抢占的下标放在不同的缓存行，避免伪共享
+    alignas(kCacheLineSize) std::atomic<size_t> m_head;
+    alignas(kCacheLineSize) std::atomic<size_t> m_tail;
+
+    alignas(kCacheLineSize) std::atomic<uint32_t> m_notEmptyEpoch; // futex 字：等待元素的消费者
+    std::atomic<int> m_popWaiters;
+    alignas(kCacheLineSize) std::atomic<uint32_t> m_notFullEpoch;  // futex 字：等待空位的生产者
+    std::atomic<int> m_pushWaiters;
+    std::atomic<bool> m_shutdown;
+};
+
+#endif
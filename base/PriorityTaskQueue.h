@@ -0,0 +1,138 @@
+// base/PriorityTaskQueue.h
+
+#ifndef PRIORITYTASKQUEUE_H
+#define PRIORITYTASKQUEUE_H
+
+#include "noncopyable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief 分优先级、按截止时间排序的阻塞队列 (互斥锁 + 条件变量，不限容量)。
+ * - 有 numClasses 个优先级，0 最高；只要高优先级还有元素，就不会取低优先级的；
+ * - 同一优先级内按截止时间最早的先出 (EDF)，没有截止时间的排在所有有截止时间的之后，
+ *   截止时间相同 (包括都没有) 的按放入顺序先进先出；
+ * - 取出的接口与 LockQueue 一致 (PopBatch / PopBatchFor / Shutdown)，可以直接换给 ThreadPool 的 worker 用。
+ * 队列本身不丢弃过期元素，由取出的一方判断。
+ */
+template<typename T>
+class PriorityTaskQueue : noncopyable
+{
+public:
+    static const int64_t kNoDeadline = std::numeric_limits<int64_t>::max();
+
+    explicit PriorityTaskQueue(size_t numClasses)
+        : m_classes(numClasses),
+          m_size(0),
+          m_nextSeq(0),
+          m_shutdown(false)
+    {}
+
+    // priorityClass 越界时按最低优先级处理；deadlineNs 是 MonoTime 纳秒，kNoDeadline 表示没有
+    void Push(T&& data, size_t priorityClass, int64_t deadlineNs = kNoDeadline)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_shutdown) return; // 与 LockQueue 一致：关闭后不再接受，data 留给调用者销毁
+            std::vector<Entry>& heap = m_classes[std::min(priorityClass, m_classes.size() - 1)];
+            heap.push_back(Entry{deadlineNs, m_nextSeq++, std::move(data)});
+            std::push_heap(heap.begin(), heap.end(), Later());
+            ++m_size;
+        }
+        m_condvariable.notify_one();
+    }
+
+    size_t Size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_size;
+    }
+
+    // 等到至少有一个元素，按优先级顺序取走最多 maxItems 个追加到 out；队列已关闭且为空时返回 false
+    bool PopBatch(std::vector<T>& out, size_t maxItems)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condvariable.wait(lock, [this] {
+            return m_size > 0 || m_shutdown;
+        });
+        return takeLocked(out, maxItems);
+    }
+
+    // 同 PopBatch，但最多等 timeout；超时也返回 false
+    template<typename Rep, typename Period>
+    bool PopBatchFor(std::vector<T>& out, size_t maxItems, std::chrono::duration<Rep, Period> timeout)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condvariable.wait_for(lock, timeout, [this] {
+            return m_size > 0 || m_shutdown;
+        });
+        return takeLocked(out, maxItems);
+    }
+
+    // 关闭后不再阻塞，已有的元素仍可以取完
+    void Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+        }
+        m_condvariable.notify_all();
+    }
+
+private:
+    struct Entry
+    {
+        int64_t deadlineNs;
+        uint64_t seq;
+        T data;
+    };
+
+    // 堆顶是“最小”的元素：截止时间早的在前，相同时先放入的在前
+    struct Later
+    {
+        bool operator()(const Entry& lhs, const Entry& rhs) const
+        {
+            if (lhs.deadlineNs != rhs.deadlineNs)
+            {
+                return lhs.deadlineNs > rhs.deadlineNs;
+            }
+            return lhs.seq > rhs.seq;
+        }
+    };
+
+    bool takeLocked(std::vector<T>& out, size_t maxItems)
+    {
+        if (m_size == 0)
+        {
+            return false;
+        }
+        size_t n = 0;
+        for (std::vector<Entry>& heap : m_classes)
+        {
+            while (n < maxItems && !heap.empty())
+            {
+                std::pop_heap(heap.begin(), heap.end(), Later());
+                out.push_back(std::move(heap.back().data));
+                heap.pop_back();
+                ++n;
+            }
+        }
+        m_size -= n;
+        return true;
+    }
+
+    std::vector<std::vector<Entry>> m_classes; // 每个优先级一个最小堆
+    size_t m_size;
+    uint64_t m_nextSeq;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condvariable;
+    bool m_shutdown;
+};
+
+#endif
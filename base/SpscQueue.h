@@ -0,0 +1,99 @@
+// base/SpscQueue.h
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include "noncopyable.h"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 有界单生产者/单消费者无锁环形队列。
+ * 只允许一个线程 TryPush、另一个线程 TryPop，两端各自只写自己的下标，
+ * 用 acquire/release 配对保证元素的可见性，没有任何锁和系统调用。
+ * 容量向上取整为 2 的幂，用位与代替取模。
+ */
+template<typename T>
+class SpscQueue : noncopyable
+{
+public:
+    explicit SpscQueue(size_t capacity)
+        : m_mask(roundUpPowerOfTwo(capacity) - 1),
+          m_slots(m_mask + 1),
+          m_head(0),
+          m_tail(0),
+          m_cachedHead(0),
+          m_cachedTail(0)
+    {}
+
+    // 生产者线程调用，队列满时返回 false，data 保持不变
+    bool TryPush(T&& data)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask)
+        {
+            // 先用缓存的 head 判断，确实满了才去读消费者的下标，减少缓存行争用
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask)
+            {
+                return false;
+            }
+        }
+        m_slots[tail & m_mask] = std::move(data);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用，队列空时返回 false
+    bool TryPop(T& data)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+            {
+                return false;
+            }
+        }
+        data = std::move(m_slots[head & m_mask]);
+        m_slots[head & m_mask] = T(); // 尽早释放元素持有的资源 (例如 shared_ptr)
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 近似值，仅用于统计
+    size_t size() const
+    {
+        return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+private:
+    static size_t roundUpPowerOfTwo(size_t n)
+    {
+        size_t size = 2;
+        while (size < n)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    static const size_t kCacheLineSize = 64;
+
+    const size_t m_mask;
+    std::vector<T> m_slots;
+
+    // 生产者和消费者的下标放在不同的缓存行，避免伪共享
+    alignas(kCacheLineSize) std::atomic<size_t> m_head; // 消费者写
+    alignas(kCacheLineSize) std::atomic<size_t> m_tail; // 生产者写
+    alignas(kCacheLineSize) size_t m_cachedHead;        // 生产者私有
+    alignas(kCacheLineSize) size_t m_cachedTail;        // 消费者私有
+};
+
+#endif
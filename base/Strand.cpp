@@ -0,0 +1,122 @@
+// base/Strand.cpp
+
+#include "Strand.h"
+
+Strand::Strand(ThreadPool* pool)
+    : m_pool(pool),
+      m_incoming(nullptr),
+      m_pending(0),
+      m_head(nullptr),
+      m_tail(nullptr)
+{}
+
+// 没执行的任务已经由 discard 丢弃，这里只是兜底
+Strand::~Strand()
+{
+    takeIncoming();
+    while (m_head != nullptr)
+    {
+        Node* next = m_head->next;
+        delete m_head;
+        m_head = next;
+    }
+}
+
+void Strand::post(Task task)
+{
+    Node* node = new Node{std::move(task), nullptr};
+    Node* head = m_incoming.load(std::memory_order_relaxed);
+    do
+    {
+        node->next = head;
+    } while (!m_incoming.compare_exchange_weak(head, node, std::memory_order_release,
+                                               std::memory_order_relaxed));
+    // 计数由 0 变 1：当前没有 drain 在排队或执行，由我们投递一个
+    if (m_pending.fetch_add(1, std::memory_order_acq_rel) == 0)
+    {
+        schedule();
+    }
+}
+
+void Strand::schedule()
+{
+    m_pool->addTask(DrainTask(shared_from_this()));
+}
+
+// 把 post 压入的栈整个取下来，反转成提交顺序接到 m_head 链表后面
+void Strand::takeIncoming()
+{
+    Node* stack = m_incoming.exchange(nullptr, std::memory_order_acquire);
+    Node* ordered = nullptr;
+    Node* last = stack;
+    while (stack != nullptr)
+    {
+        Node* next = stack->next;
+        stack->next = ordered;
+        ordered = stack;
+        stack = next;
+    }
+    if (ordered == nullptr)
+    {
+        return;
+    }
+    if (m_tail != nullptr)
+    {
+        m_tail->next = ordered;
+    }
+    else
+    {
+        m_head = ordered;
+    }
+    m_tail = last;
+}
+
+void Strand::drain()
+{
+    size_t ran = 0;
+    while (ran < kMaxBatch)
+    {
+        if (m_head == nullptr)
+        {
+            takeIncoming();
+            if (m_head == nullptr)
+            {
+                break;
+            }
+        }
+        Node* node = m_head;
+        m_head = node->next;
+        if (m_head == nullptr)
+        {
+            m_tail = nullptr;
+        }
+        node->task();
+        delete node;
+        ++ran;
+    }
+    // 计数里的任务都已经压栈，还有剩余就重新排队，由下一次 drain (可能在别的 worker 上) 接着执行
+    if (m_pending.fetch_sub(ran, std::memory_order_acq_rel) > ran)
+    {
+        schedule();
+    }
+}
+
+// 线程池已关闭，drain 不会执行：丢弃已经排队的任务 (submit 的句柄随 TaskRunner 销毁以 abandoned 结束)。
+// 与 drain 一样由计数保证同一时刻只有一个；计数没有归零说明期间又有任务压栈，接着丢
+void Strand::discard()
+{
+    size_t dropped;
+    do
+    {
+        dropped = 0;
+        takeIncoming();
+        while (m_head != nullptr)
+        {
+            Node* next = m_head->next;
+            delete m_head;
+            m_head = next;
+            ++dropped;
+        }
+        m_tail = nullptr;
+    } while (m_pending.fetch_sub(dropped, std::memory_order_acq_rel) > dropped);
+}
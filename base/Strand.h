@@ -0,0 +1,97 @@
+// base/Strand.h
+
+#ifndef STRAND_H
+#define STRAND_H
+
+#include "noncopyable.h"
+#include "ThreadPool.h"
+#include "TaskFuture.h"
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 建在 ThreadPool 之上的串行执行器：同一个 Strand 上的任务按提交顺序逐个执行，
+ * 可能落在不同的 worker 上，但不会同时执行；不同 Strand 的任务之间照常并行。
+ * - 不占用 worker：没有任务时 Strand 不在线程池里；有任务时只投递一个 drain，
+ *   由它执行一小批 (kMaxBatch) 任务，还有剩余就重新排到线程池队尾，让其它 Strand 也能轮到；
+ * - 不加锁：post 把任务挂到无锁栈上，再用一个计数决定谁负责投递 drain，worker 不会因为别的 Strand 阻塞；
+ * - 任务之间的内存可见性由 Strand 保证，同一个 Strand 上的任务可以不加锁地访问同一份状态。
+ * 用 std::make_shared 创建；排队中的 drain 持有 shared_ptr，Strand 会活到任务都执行完。
+ * 线程池关闭后 drain 不再执行，排队的任务被丢弃，submit 的句柄以 abandoned() 结束。
+ * 线程池使用有界的 kMpmcQueue 时，队列满会让 post 阻塞 (与 addTask 相同)。
+ */
+class Strand : noncopyable, public std::enable_shared_from_this<Strand>
+{
+public:
+    using Task = ThreadPool::Task;
+
+    explicit Strand(ThreadPool* pool);
+    ~Strand();
+
+    // 任意线程
+    void post(Task task);
+
+    // 与 ThreadPool::submit 相同，返回的句柄可以 then(loop, cb) 让结果回到 loop 线程；
+    // 同一个 Strand 上的任务按顺序完成，送到同一个 loop 的结果也按这个顺序执行
+    template<typename Fn>
+    TaskFuture<std::invoke_result_t<std::decay_t<Fn>&>> submit(Fn&& fn)
+    {
+        using R = std::invoke_result_t<std::decay_t<Fn>&>;
+        TaskState<R>* state = new TaskStateImpl<R, std::decay_t<Fn>>(std::forward<Fn>(fn));
+        post(TaskRunner<R>(state));
+        return TaskFuture<R>(state);
+    }
+
+    ThreadPool* pool() const { return m_pool; }
+
+private:
+    struct Node
+    {
+        Task task;
+        Node* next;
+    };
+
+    // 投递到线程池的 drain，没有执行就被销毁 (线程池已关闭) 时改为 discard
+    class DrainTask
+    {
+    public:
+        explicit DrainTask(std::shared_ptr<Strand> strand) : m_strand(std::move(strand)) {}
+        DrainTask(DrainTask&&) noexcept = default;
+        ~DrainTask()
+        {
+            if (m_strand)
+            {
+                m_strand->discard();
+            }
+        }
+
+        void operator()()
+        {
+            std::shared_ptr<Strand> strand = std::move(m_strand);
+            strand->drain();
+        }
+
+    private:
+        std::shared_ptr<Strand> m_strand;
+    };
+
+    // 一次 drain 最多执行的任务数，执行完还有剩余就让出 worker
+    static const size_t kMaxBatch = 32;
+
+    void schedule();
+    void drain();
+    void discard();
+    void takeIncoming();
+
+    ThreadPool* m_pool;
+    std::atomic<Node*> m_incoming; // post 压入的无锁栈 (后进先出)
+    std::atomic<size_t> m_pending; // 已 post 还没执行完的任务数，由 0 变 1 的那次 post 负责投递 drain
+    // 以下只由当前的 drain 访问 (同一时刻最多一个)
+    Node* m_head; // 按提交顺序排好的待执行任务
+    Node* m_tail;
+};
+
+#endif
@@ -0,0 +1,363 @@
+// base/TaskFuture.h
+
+#ifndef TASKFUTURE_H
+#define TASKFUTURE_H
+
+#include "noncopyable.h"
+#include "Futex.h"
+
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 需要在某个线程 (通常是 EventLoop 线程) 上执行的完成通知，由 CompletionQueue 串成链表。
+ * complete() 在目标线程上调用一次，负责执行回调并释放自己。
+ */
+class Completion
+{
+public:
+    virtual void complete() = 0;
+
+protected:
+    virtual ~Completion() = default;
+
+private:
+    friend class CompletionQueue;
+    Completion* m_next = nullptr;
+};
+
+/**
+ * @brief 多生产者/单消费者的无锁完成队列 (Treiber 栈)。
+ * 生产者 push 时如果队列原来是空的，push 返回 true，由它安排一次 drain (例如 EventLoop::queueInLoop)；
+ * 之后到达的完成通知只挂到链表上，由同一次 drain 成批处理，不再加锁、不再唤醒。
+ */
+class CompletionQueue : noncopyable
+{
+public:
+    CompletionQueue() : m_head(nullptr) {}
+
+    // 任意线程；返回 true 表示调用者需要安排一次 drain
+    bool push(Completion* completion)
+    {
+        Completion* head = m_head.load(std::memory_order_relaxed);
+        do
+        {
+            completion->m_next = head;
+        } while (!m_head.compare_exchange_weak(head, completion, std::memory_order_release,
+                                               std::memory_order_relaxed));
+        return head == nullptr;
+    }
+
+    // 消费者线程；按放入顺序执行已有的全部完成通知，返回个数
+    size_t drain()
+    {
+        Completion* head = m_head.exchange(nullptr, std::memory_order_acquire);
+        // 栈是后进先出，先反转成放入顺序
+        Completion* ordered = nullptr;
+        while (head != nullptr)
+        {
+            Completion* next = head->m_next;
+            head->m_next = ordered;
+            ordered = head;
+            head = next;
+        }
+        size_t count = 0;
+        while (ordered != nullptr)
+        {
+            Completion* next = ordered->m_next;
+            ordered->complete();
+            ordered = next;
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    std::atomic<Completion*> m_head;
+};
+
+// 任务结果的回调类型：void 任务的回调不带参数
+template<typename R>
+struct TaskCallback
+{
+    using type = std::function<void(R)>;
+};
+
+template<>
+struct TaskCallback<void>
+{
+    using type = std::function<void()>;
+};
+
+/**
+ * @brief submit 出去的一个任务的共享状态：结果、continuation 和引用计数 (句柄一份，任务一份)。
+ * 状态字的各个位只增不减，worker 和注册 continuation 的线程各自 fetch_or，
+ * 谁后到谁负责投递，不需要锁。
+ */
+template<typename R>
+class TaskState : public Completion
+{
+public:
+    using Callback = typename TaskCallback<R>::type;
+    using DeliverFunc = void (*)(void* executor, Completion* completion);
+    // void 任务没有结果，用 bool 占位 (不会被赋值)
+    using Storage = std::conditional_t<std::is_void<R>::value, bool, R>;
+
+    // worker 线程：执行任务，然后投递 continuation 或者释放任务持有的引用
+    void run()
+    {
+        if constexpr (std::is_void<R>::value)
+        {
+            invoke();
+        }
+        else
+        {
+            m_result.emplace(invoke());
+        }
+        uint32_t old = m_state.fetch_or(kDone, std::memory_order_acq_rel);
+        if (old & kHasWaiter)
+        {
+            futexWake(&m_state, INT_MAX);
+        }
+        if (old & kHasContinuation)
+        {
+            m_deliver(m_executor, this); // 任务的引用转交给完成队列
+        }
+        else
+        {
+            release();
+        }
+    }
+
+    // 任务没有执行就被销毁 (线程池已关闭、拒收)：以“放弃”结束，唤醒等待者，释放任务持有的引用。
+    // 已注册的 continuation 不会执行 (没有结果可交)，它捕获的资源随状态一起释放
+    void abandon()
+    {
+        uint32_t old = m_state.fetch_or(kDone | kAbandoned, std::memory_order_acq_rel);
+        if (old & kHasWaiter)
+        {
+            futexWake(&m_state, INT_MAX);
+        }
+        release();
+    }
+
+    void setContinuation(void* executor, DeliverFunc deliver, Callback cb)
+    {
+        m_executor = executor;
+        m_deliver = deliver;
+        m_callback = std::move(cb);
+        uint32_t old = m_state.fetch_or(kHasContinuation, std::memory_order_acq_rel);
+        assert(!(old & kHasContinuation));
+        if (old & kAbandoned)
+        {
+            m_callback = nullptr;
+            return;
+        }
+        if (old & kDone)
+        {
+            // 任务已经结束并释放了它的引用，给完成队列另加一份
+            m_refs.fetch_add(1, std::memory_order_relaxed);
+            m_deliver(m_executor, this);
+        }
+    }
+
+    bool ready() const { return m_state.load(std::memory_order_acquire) & kDone; }
+    bool abandoned() const { return m_state.load(std::memory_order_acquire) & kAbandoned; }
+
+    void wait()
+    {
+        uint32_t state = m_state.load(std::memory_order_acquire);
+        while (!(state & kDone))
+        {
+            if (!(state & kHasWaiter))
+            {
+                state = m_state.fetch_or(kHasWaiter, std::memory_order_acq_rel) | kHasWaiter;
+                continue;
+            }
+            futexWait(&m_state, state);
+            state = m_state.load(std::memory_order_acquire);
+        }
+    }
+
+    std::optional<Storage>& result() { return m_result; }
+
+    void release()
+    {
+        if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete this;
+        }
+    }
+
+protected:
+    TaskState() : m_state(0), m_refs(2), m_executor(nullptr), m_deliver(nullptr) {}
+
+    virtual R invoke() = 0;
+
+private:
+    static const uint32_t kDone = 1;
+    static const uint32_t kHasContinuation = 2;
+    static const uint32_t kHasWaiter = 4;
+    static const uint32_t kAbandoned = 8;
+
+    // 在 continuation 指定的线程上调用
+    void complete() override
+    {
+        if constexpr (std::is_void<R>::value)
+        {
+            m_callback();
+        }
+        else
+        {
+            m_callback(std::move(*m_result));
+        }
+        m_callback = nullptr;
+        release();
+    }
+
+    std::atomic<uint32_t> m_state;  // futex 字，get() 在上面等待
+    std::atomic<int> m_refs;
+    std::optional<Storage> m_result;
+    void* m_executor;
+    DeliverFunc m_deliver;
+    Callback m_callback;
+};
+
+/**
+ * @brief 投递给执行者 (ThreadPool / Strand) 的可调用对象，持有任务的那一份引用。
+ * 执行时交给 TaskState::run；没有执行就被销毁 (例如 shutdown 之后提交、队列拒收) 时
+ * 调用 abandon，句柄上的 wait / get 不会一直阻塞，状态也不会泄漏。
+ */
+template<typename R>
+class TaskRunner
+{
+public:
+    explicit TaskRunner(TaskState<R>* state) : m_state(state) {}
+    TaskRunner(TaskRunner&& other) noexcept : m_state(other.m_state) { other.m_state = nullptr; }
+    TaskRunner& operator=(TaskRunner&&) = delete;
+    TaskRunner(const TaskRunner&) = delete;
+    TaskRunner& operator=(const TaskRunner&) = delete;
+
+    ~TaskRunner()
+    {
+        if (m_state != nullptr)
+        {
+            m_state->abandon();
+        }
+    }
+
+    void operator()()
+    {
+        TaskState<R>* state = m_state;
+        m_state = nullptr;
+        state->run();
+    }
+
+private:
+    TaskState<R>* m_state;
+};
+
+template<typename R, typename Fn>
+class TaskStateImpl : public TaskState<R>
+{
+public:
+    explicit TaskStateImpl(Fn&& fn) : m_fn(std::move(fn)) {}
+    explicit TaskStateImpl(const Fn& fn) : m_fn(fn) {}
+
+private:
+    R invoke() override { return m_fn(); }
+
+    Fn m_fn;
+};
+
+/**
+ * @brief ThreadPool::submit 返回的句柄。
+ * - then(loop, cb)：任务完成后在 loop 线程上执行 cb(结果)；worker 线程不加锁，
+ *   同一个 loop 上先后完成的多个任务通过 loop 的完成队列成批投递，只占用一次 pending functor；
+ * - get()：阻塞等待并取走结果 (在 futex 上等待)，不要在 loop 线程上调用；
+ * then 与 get 只能使用其中一个，各自最多一次。句柄可以在任务完成前销毁，不影响任务和 continuation。
+ * 任务没有执行就被丢弃时 (见 TaskRunner)，句柄以 abandoned() 结束：wait() 返回，
+ * get() 终止程序 (与是否定义 NDEBUG 无关；调用前可以先 wait() 再检查 abandoned())，then 的回调不会执行。
+ */
+template<typename R>
+class TaskFuture
+{
+public:
+    using Callback = typename TaskCallback<R>::type;
+
+    TaskFuture() : m_state(nullptr) {}
+    explicit TaskFuture(TaskState<R>* state) : m_state(state) {}
+    TaskFuture(TaskFuture&& other) noexcept : m_state(other.m_state) { other.m_state = nullptr; }
+    TaskFuture& operator=(TaskFuture&& other) noexcept
+    {
+        std::swap(m_state, other.m_state);
+        return *this;
+    }
+    TaskFuture(const TaskFuture&) = delete;
+    TaskFuture& operator=(const TaskFuture&) = delete;
+
+    ~TaskFuture()
+    {
+        if (m_state != nullptr)
+        {
+            m_state->release();
+        }
+    }
+
+    bool valid() const { return m_state != nullptr; }
+    bool ready() const { return m_state->ready(); }
+    // 任务没有执行就被丢弃了，只在 ready() 之后有意义
+    bool abandoned() const { return m_state->abandoned(); }
+
+    // Loop 需要提供 queueCompletion(Completion*) (见 EventLoop)，模板参数避免 base 依赖 net
+    template<typename Loop>
+    void then(Loop* loop, Callback cb)
+    {
+        m_state->setContinuation(loop, &deliverTo<Loop>, std::move(cb));
+    }
+
+    void wait() { m_state->wait(); }
+
+    template<typename T = R>
+    std::enable_if_t<!std::is_void<T>::value, T> get()
+    {
+        m_state->wait();
+        abortIfAbandoned();
+        return std::move(*m_state->result());
+    }
+
+    template<typename T = R>
+    std::enable_if_t<std::is_void<T>::value> get()
+    {
+        m_state->wait();
+        abortIfAbandoned();
+    }
+
+private:
+    // 被丢弃的任务没有结果可取，继续下去就是读一个空的 optional
+    void abortIfAbandoned() const
+    {
+        if (m_state->abandoned())
+        {
+            fputs("TaskFuture::get: task was dropped without running\n", stderr);
+            abort();
+        }
+    }
+
+    template<typename Loop>
+    static void deliverTo(void* loop, Completion* completion)
+    {
+        static_cast<Loop*>(loop)->queueCompletion(completion);
+    }
+
+    TaskState<R>* m_state;
+};
+
+#endif
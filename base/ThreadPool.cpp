@@ -2,76 +2,313 @@
 
 #include "ThreadPool.h"
 #include "Logger.h"
+#include "CurrentThread.h"
+#include "MonoTime.h"
+
+#include <algorithm>
+#include <chrono>
 
 ThreadPool::ThreadPool(int threadNum, const std::string& name)
     : m_name(name),
       m_threadNum(threadNum),
-      m_started(false)
+      m_elastic(false),
+      m_nextId(0),
+      m_started(false),
+      m_stopping(false),
+      m_liveThreads(0),
+      m_idleThreads(0),
+      m_completedTasks(0),
+      m_queueWaitUsTotal(0),
+      m_queueWaitUsMax(0),
+      m_threadsGrown(0),
+      m_threadsRetired(0),
+      m_expiredTasks(0)
 {}
 
-// 【核心】修改析构函数，实现优雅关闭
+// 【核心】修改析构函数，实现优雅关闭：关闭任务队列，等待所有线程结束
 ThreadPool::~ThreadPool()
 {
-    if (m_started)
+    shutdown();
+}
+
+void ThreadPool::setQueueType(QueueType type, size_t capacity)
+{
+    m_mpmcQueue.reset();
+    m_priorityQueue.reset();
+    if (type == QueueType::kMpmcQueue)
     {
-        // 1. 关闭任务队列
-        m_taskQueue.Shutdown();
-        // 2. 等待所有线程结束
-        for (auto& thread_ptr : m_threads)
-        {
-            thread_ptr->join();
-        }
+        m_mpmcQueue = std::make_unique<MpmcQueue<QueuedTask>>(capacity);
+    }
+    else if (type == QueueType::kPriorityQueue)
+    {
+        m_priorityQueue = std::make_unique<PriorityTaskQueue<QueuedTask>>(kNumPriorities);
+    }
+}
+
+void ThreadPool::setElastic(const ElasticOptions& options)
+{
+    m_elastic = true;
+    m_options = options;
+    if (m_options.minThreads < 1)
+    {
+        m_options.minThreads = 1;
+    }
+    if (m_options.maxThreads < m_options.minThreads)
+    {
+        m_options.maxThreads = m_options.minThreads;
     }
 }
 
 void ThreadPool::start()
 {
     m_started = true;
+    int threadNum = m_elastic ? m_options.minThreads : m_threadNum;
     //找人进来
-    m_threads.reserve(m_threadNum);
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    m_liveThreads = threadNum;
+    m_idleThreads = m_elastic ? threadNum : 0;
     //分配工作
-    for (int i = 0; i < m_threadNum; ++i)
+    for (int i = 0; i < threadNum; ++i)
     {
-        // 将 std::bind 替换为了下面的 lambda 表达式
-        //lambda表达式其实就是对要完成函数的一个包装
-        m_threads.emplace_back(std::make_unique<Thread>(
-            [this]() { threadFunc(); }, 
-            m_name + std::to_string(i)
-        ));//创建过程并不执行threadFunc()，只是创建了一个线程对象
-        m_threads[i]->start();
-        //这里函数的执行切换了线程，所以这里的start()函数是异步的,while(true)不影响for函数的执行
+        spawnLocked();
     }
 }
 
+// 调用者已经把这个线程计入 m_liveThreads (弹性模式下还有 m_idleThreads)
+void ThreadPool::spawnLocked()
+{
+    int id = m_nextId++;
+    // lambda表达式其实就是对要完成函数的一个包装
+    // 创建过程并不执行threadFunc()，只是创建了一个线程对象
+    std::unique_ptr<Thread> thread = std::make_unique<Thread>(
+        [this, id]() { threadFunc(id); },
+        m_name + std::to_string(id));
+    // 这里函数的执行切换了线程，所以这里的start()函数是异步的
+    thread->start();
+    m_threads.emplace(id, std::move(thread));
+}
+
 void ThreadPool::addTask(Task task)
 {
-    m_taskQueue.Push(std::move(task));
+    enqueue(QueuedTask{std::move(task), MonoTime::now().nanoSeconds(), 0, nullptr}, Priority::kNormal);
 }
 
-// 每个线程调用的不是一个简单的任务,而是这么一个流程,并且会因为while(true)一直工作
-void ThreadPool::threadFunc()
+void ThreadPool::addTask(Task task, Priority priority, MonoTime deadline, Task onExpired)
 {
-    LOG_INFO << "Worker thread started in thread " << std::this_thread::get_id();
-    while (true)
+    std::unique_ptr<Task> expired = onExpired ? std::make_unique<Task>(std::move(onExpired)) : nullptr;
+    enqueue(QueuedTask{std::move(task), MonoTime::now().nanoSeconds(), deadline.nanoSeconds(), std::move(expired)},
+            priority);
+}
+
+void ThreadPool::enqueue(QueuedTask&& item, Priority priority)
+{
+    if (m_priorityQueue)
+    {
+        int64_t deadlineNs = item.deadlineNs > 0 ? item.deadlineNs : PriorityTaskQueue<QueuedTask>::kNoDeadline;
+        m_priorityQueue->Push(std::move(item), static_cast<size_t>(priority), deadlineNs);
+    }
+    else if (m_mpmcQueue)
+    {
+        m_mpmcQueue->Push(std::move(item));
+    }
+    else
+    {
+        m_taskQueue.Push(std::move(item));
+    }
+    // 所有线程都在忙而任务还在堆积，不等排队时间超标就先加线程
+    if (m_elastic && m_idleThreads.load(std::memory_order_relaxed) == 0 &&
+        queuedTasks() > m_options.growQueueDepth)
     {
-        // Pop 现在返回一个 optional
-        auto task_opt = m_taskQueue.Pop();
+        grow();
+    }
+}
+
+void ThreadPool::shutdownQueue()
+{
+    if (m_mpmcQueue)
+    {
+        m_mpmcQueue->Shutdown();
+    }
+    if (m_priorityQueue)
+    {
+        m_priorityQueue->Shutdown();
+    }
+    m_taskQueue.Shutdown();
+}
+
+size_t ThreadPool::queuedTasks() const
+{
+    if (m_priorityQueue)
+    {
+        return m_priorityQueue->Size();
+    }
+    return m_mpmcQueue ? m_mpmcQueue->Size() : m_taskQueue.Size();
+}
 
-        if (task_opt)
+void ThreadPool::grow()
+{
+    int live = m_liveThreads.load();
+    do
+    {
+        if (live >= m_options.maxThreads)
         {
-            // 如果 optional 有值，就执行任务
-            Task task = task_opt.value();
-            if (task)
+            return;
+        }
+    } while (!m_liveThreads.compare_exchange_weak(live, live + 1));
+    // 新线程立刻算作空闲，避免并发的 addTask 看到 0 个空闲线程又各自加一个
+    m_idleThreads.fetch_add(1);
+
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    reapRetiredLocked();
+    if (m_stopping)
+    {
+        m_liveThreads.fetch_sub(1);
+        m_idleThreads.fetch_sub(1);
+        return;
+    }
+    spawnLocked();
+    m_threadsGrown.fetch_add(1, std::memory_order_relaxed);
+    LOG_DEBUG << m_name << " grew to " << live + 1 << " threads";
+}
+
+// 空闲超时的线程退出，但至少保留 minThreads 个
+bool ThreadPool::tryRetire(int id)
+{
+    int live = m_liveThreads.load();
+    do
+    {
+        if (live <= m_options.minThreads)
+        {
+            return false;
+        }
+    } while (!m_liveThreads.compare_exchange_weak(live, live - 1));
+    m_idleThreads.fetch_sub(1);
+    m_threadsRetired.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    m_retiredIds.push_back(id); // 自己不能 join 自己，留给下一次 grow 或 shutdown
+    return true;
+}
+
+void ThreadPool::reapRetiredLocked()
+{
+    for (int id : m_retiredIds)
+    {
+        auto it = m_threads.find(id);
+        if (it != m_threads.end())
+        {
+            it->second->join();
+            m_threads.erase(it);
+        }
+    }
+    m_retiredIds.clear();
+}
+
+void ThreadPool::recordWait(const std::vector<QueuedTask>& batch)
+{
+    // 一批任务只读一次时钟、只更新一次计数器
+    int64_t now = MonoTime::now().nanoSeconds();
+    uint64_t totalUs = 0;
+    uint64_t maxUs = 0;
+    for (const QueuedTask& item : batch)
+    {
+        int64_t waitNs = now - item.enqueueNs;
+        uint64_t waitUs = waitNs > 0 ? static_cast<uint64_t>(waitNs / MonoTime::kNanoSecondsPerMicroSecond) : 0;
+        totalUs += waitUs;
+        maxUs = std::max(maxUs, waitUs);
+    }
+    m_queueWaitUsTotal.fetch_add(totalUs, std::memory_order_relaxed);
+    uint64_t oldMax = m_queueWaitUsMax.load(std::memory_order_relaxed);
+    while (maxUs > oldMax && !m_queueWaitUsMax.compare_exchange_weak(oldMax, maxUs, std::memory_order_relaxed))
+    {
+    }
+
+    // 任务排队太久而且没有空闲线程，说明线程不够用了
+    if (m_elastic && maxUs > static_cast<uint64_t>(m_options.growWaitUs) &&
+        m_idleThreads.load(std::memory_order_relaxed) == 0)
+    {
+        grow();
+    }
+}
+
+// 【修改】一次取走一批任务，减少 worker 之间对队列的争抢
+template<typename Queue>
+void ThreadPool::runTasks(Queue& queue, int id, size_t batchSize)
+{
+    std::vector<QueuedTask> batch;
+    batch.reserve(batchSize);
+    const std::chrono::milliseconds idleTimeout(m_options.idleTimeoutMs);
+    while (true)
+    {
+        batch.clear();
+        bool popped = m_elastic ? queue.PopBatchFor(batch, batchSize, idleTimeout)
+                                : queue.PopBatch(batch, batchSize);
+        if (!popped)
+        {
+            // 队列已关闭且为空，收到“下班”信号，退出循环
+            if (!m_elastic || m_stopping)
+            {
+                break;
+            }
+            // 弹性模式下空闲超时
+            if (tryRetire(id))
+            {
+                return;
+            }
+            continue;
+        }
+        if (m_elastic)
+        {
+            m_idleThreads.fetch_sub(1);
+        }
+        recordWait(batch);
+        for (QueuedTask& item : batch)
+        {
+            // 【新增】过了截止时间的任务不再执行，交给 onExpired
+            if (item.deadlineNs > 0 && MonoTime::now().nanoSeconds() > item.deadlineNs)
+            {
+                m_expiredTasks.fetch_add(1, std::memory_order_relaxed);
+                if (item.onExpired)
+                {
+                    (*item.onExpired)();
+                }
+                continue;
+            }
+            if (item.task)
             {
-                task();
+                item.task();
             }
         }
-        else // 如果返回的是空 optional，说明队列已关闭且为空
+        m_completedTasks.fetch_add(batch.size(), std::memory_order_relaxed);
+        if (m_elastic)
         {
-            // 收到“下班”信号，退出循环
-            break; 
+            m_idleThreads.fetch_add(1);
         }
     }
+    m_liveThreads.fetch_sub(1);
+    if (m_elastic)
+    {
+        m_idleThreads.fetch_sub(1);
+    }
+}
+
+// 每个线程调用的不是一个简单的任务,而是这么一个流程,并且会一直工作到关闭或者 (弹性模式下) 空闲超时
+void ThreadPool::threadFunc(int id)
+{
+    LOG_INFO << "Worker thread started in thread " << CurrentThread::tid();
+    if (m_priorityQueue)
+    {
+        // 一次只取一个：成批取走的低优先级任务会挡住随后到达的高优先级任务
+        runTasks(*m_priorityQueue, id, 1);
+    }
+    else if (m_mpmcQueue)
+    {
+        runTasks(*m_mpmcQueue, id, kTaskBatch);
+    }
+    else
+    {
+        runTasks(m_taskQueue, id, kTaskBatch);
+    }
     LOG_INFO << "Worker thread exited.";
 }
 
@@ -84,16 +321,41 @@ void ThreadPool::shutdown()
 
     LOG_INFO << "ThreadPool is shutting down...";
 
-    // 1. 关闭任务队列的入口，这是调用内部成员 LockQueue 的 Shutdown
-    m_taskQueue.Shutdown(); 
-    
-    // 2. 等待并回收所有工作线程
-    for (auto& thread_ptr : m_threads)
+    // 1. 关闭任务队列的入口，这是调用内部成员 LockQueue (或 MpmcQueue) 的 Shutdown
+    //    先置 m_stopping，之后 grow 不会再加线程
+    std::map<int, std::unique_ptr<Thread>> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        m_stopping = true;
+        threads.swap(m_threads);
+    }
+    shutdownQueue();
+
+    // 2. 等待并回收所有工作线程 (不持有锁，退出中的线程可能还要登记自己)
+    for (auto& entry : threads)
     {
-        thread_ptr->join();
+        entry.second->join();
     }
 
     // 3. 清理状态
-    m_threads.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        m_retiredIds.clear();
+    }
     m_started = false;
-}
\ No newline at end of file
+}
+
+ThreadPool::Stats ThreadPool::stats() const
+{
+    Stats stats;
+    stats.threads = m_liveThreads.load();
+    stats.idleThreads = m_idleThreads.load();
+    stats.queuedTasks = queuedTasks();
+    stats.completedTasks = m_completedTasks.load(std::memory_order_relaxed);
+    stats.queueWaitUsTotal = m_queueWaitUsTotal.load(std::memory_order_relaxed);
+    stats.queueWaitUsMax = m_queueWaitUsMax.load(std::memory_order_relaxed);
+    stats.threadsGrown = m_threadsGrown.load(std::memory_order_relaxed);
+    stats.threadsRetired = m_threadsRetired.load(std::memory_order_relaxed);
+    stats.expiredTasks = m_expiredTasks.load(std::memory_order_relaxed);
+    return stats;
+}
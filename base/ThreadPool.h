@@ -6,37 +6,161 @@
 #include "noncopyable.h"
 #include "Thread.h"
 #include "LockQueue.h"
+#include "MpmcQueue.h"
+#include "PriorityTaskQueue.h"
+#include "MonoTime.h"
+#include "TaskFuture.h"
+#include "UniqueFunction.h"
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <memory>
 
 class ThreadPool : noncopyable
 {
 public:
-    using Task = std::function<void()>;
+    // 【修改】任务只会被移动，用 UniqueFunction：常见的捕获不用堆分配，也可以捕获只能移动的对象
+    using Task = UniqueFunction<void()>;
+
+    // 【新增】任务队列的实现
+    enum class QueueType
+    {
+        kLockQueue, // 默认：互斥锁 + 条件变量，不限容量
+        kMpmcQueue, // 有界无锁环形队列，满时 addTask 阻塞
+        kPriorityQueue, // 按优先级、同一优先级内按截止时间 (EDF) 调度，不限容量
+    };
+
+    // 【新增】任务的优先级，只在 kPriorityQueue 下影响调度顺序
+    enum class Priority
+    {
+        kHigh,   // 延迟敏感的请求
+        kNormal, // addTask(task) 的默认优先级
+        kLow,    // 后台批量任务
+    };
+
+    // 【新增】弹性模式的参数：线程数在 [minThreads, maxThreads] 之间伸缩
+    struct ElasticOptions
+    {
+        int minThreads = 1;
+        int maxThreads = 16;
+        int64_t growWaitUs = 1000;  // 任务排队超过这么久、且没有空闲线程时加一个线程
+        size_t growQueueDepth = 64; // addTask 时队列深度超过它、且没有空闲线程时加一个线程
+        int idleTimeoutMs = 10000;  // 空闲这么久的线程退出 (保留 minThreads 个)
+    };
+
+    // 【新增】运行统计，各项分别读取，彼此之间不保证是同一时刻的快照
+    struct Stats
+    {
+        int threads;               // 当前线程数
+        int idleThreads;           // 正在等任务的线程数 (只在弹性模式下统计)
+        size_t queuedTasks;        // 队列中等待的任务数
+        uint64_t completedTasks;
+        uint64_t queueWaitUsTotal; // 所有已取出任务的排队时间之和，除以 completedTasks 得平均值
+        uint64_t queueWaitUsMax;
+        uint64_t threadsGrown;
+        uint64_t threadsRetired;
+        uint64_t expiredTasks;     // 过了截止时间而没有执行的任务
+    };
 
     ThreadPool(int threadNum, const std::string& name = std::string("ThreadPool"));
     ~ThreadPool();
 
+    // 【新增】必须在 start 之前调用；开启后构造函数的 threadNum 不再使用，start 只启动 minThreads 个线程
+    void setElastic(const ElasticOptions& options);
+
+    // 必须在 start 之前调用；capacity 只对 kMpmcQueue 有效。
+    // 注意任务中再 addTask 时，队列满会让所有 worker 都阻塞在 addTask 上，容量要留足
+    // (LockQueue 默认不限容量，没有这个问题)
+    void setQueueType(QueueType type, size_t capacity = kDefaultMpmcCapacity);
+
     // 启动线程池
     void start();
 
     // 向线程池添加任务
     void addTask(Task task);
 
+    // 【新增】带优先级和截止时间 (MonoTime，默认没有) 的任务。
+    // worker 取出任务时如果已经过了截止时间，就不再执行 task，改为调用 onExpired (可以为空)，
+    // 例如给客户端回一个超时错误。截止时间对所有队列类型都生效，优先级只在 kPriorityQueue 下生效。
+    void addTask(Task task, Priority priority, MonoTime deadline = MonoTime(), Task onExpired = Task());
+
+    // 【新增】把计算任务交给线程池，返回的句柄可以 then(loop, cb) 让结果回到 loop 线程处理：
+    //   pool.submit([req] { return compute(req); }).then(loop, [conn](Response r) { conn->send(r); });
+    // 任务和结果放在同一次分配的共享状态里，投递给线程池的 Task 只捕获一个指针。
+    // shutdown 之后提交的任务不会执行，句柄以 abandoned() 结束 (见 TaskFuture)。
+    template<typename Fn>
+    TaskFuture<std::invoke_result_t<std::decay_t<Fn>&>> submit(Fn&& fn)
+    {
+        using R = std::invoke_result_t<std::decay_t<Fn>&>;
+        TaskState<R>* state = new TaskStateImpl<R, std::decay_t<Fn>>(std::forward<Fn>(fn));
+        addTask(TaskRunner<R>(state));
+        return TaskFuture<R>(state);
+    }
+
     void shutdown();
 
-    
+    Stats stats() const;
+
 private:
-    void threadFunc(); // 线程池中每个工作线程运行的函数
+    // 每个 worker 一次从队列取走的最多任务数；取大了长任务会压住同一批里的其它任务，
+    // 而别的 worker 可能空闲，所以只取一小批
+    static const size_t kTaskBatch = 8;
+    static const size_t kDefaultMpmcCapacity = 64 * 1024;
+
+    static constexpr size_t kNumPriorities = 3;
+
+    // 队列里的任务带着入队时刻，用来统计排队时间
+    struct QueuedTask
+    {
+        Task task;
+        int64_t enqueueNs;
+        int64_t deadlineNs; // 0 表示没有截止时间
+        std::unique_ptr<Task> onExpired; // 很少用到，放在堆上，让队列元素保持紧凑
+    };
+
+    void threadFunc(int id); // 线程池中每个工作线程运行的函数
+    template<typename Queue>
+    void runTasks(Queue& queue, int id, size_t batchSize);
+    void enqueue(QueuedTask&& item, Priority priority);
+    void recordWait(const std::vector<QueuedTask>& batch);
+    void shutdownQueue();
+    size_t queuedTasks() const;
+
+    void spawnLocked();
+    void grow();
+    bool tryRetire(int id);
+    void reapRetiredLocked();
 
     std::string m_name;
     int m_threadNum;//线程池应该有多少个线程
-    std::vector<std::unique_ptr<Thread>> m_threads; // 线程列表  这里用unique_ptr是因为线程池应该独享线程资源,管理其中线程的生命周期
-    LockQueue<Task> m_taskQueue; // 任务队列
+    bool m_elastic;
+    ElasticOptions m_options;
+
+    std::mutex m_threadsMutex; // 保护 m_threads / m_retiredIds / m_nextId，弹性模式下 worker 线程也会增减线程
+    std::map<int, std::unique_ptr<Thread>> m_threads; // 线程列表 (按编号)  这里用unique_ptr是因为线程池应该独享线程资源,管理其中线程的生命周期
+    std::vector<int> m_retiredIds; // 已经退出、还没 join 的线程
+    int m_nextId;
+
+    LockQueue<QueuedTask> m_taskQueue; // 任务队列
+    std::unique_ptr<MpmcQueue<QueuedTask>> m_mpmcQueue; // 选择 kMpmcQueue 时代替 m_taskQueue
+    std::unique_ptr<PriorityTaskQueue<QueuedTask>> m_priorityQueue; // 选择 kPriorityQueue 时代替 m_taskQueue
     std::atomic_bool m_started;// 必须假设它可能会在更复杂的环境中使用——比如，一个线程创建并 start() 线程池，而另一个线程在未来的某个时刻决定要销毁这个线程池
+    std::atomic_bool m_stopping;
+
+    std::atomic<int> m_liveThreads;
+    std::atomic<int> m_idleThreads;
+    std::atomic<uint64_t> m_completedTasks;
+    std::atomic<uint64_t> m_queueWaitUsTotal;
+    std::atomic<uint64_t> m_queueWaitUsMax;
+    std::atomic<uint64_t> m_threadsGrown;
+    std::atomic<uint64_t> m_threadsRetired;
+    std::atomic<uint64_t> m_expiredTasks;
 };
 
 #endif
\ No newline at end of file
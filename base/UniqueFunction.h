@@ -0,0 +1,196 @@
+// base/UniqueFunction.h
+
+#ifndef UNIQUEFUNCTION_H
+#define UNIQUEFUNCTION_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature, size_t InlineSize = 48>
+class UniqueFunction;
+
+/**
+ * @brief 只能移动的可调用对象包装，用在 queueInLoop / 定时器 / Channel 回调这类热路径上代替 std::function。
+ * - 内联缓冲区 InlineSize (默认 48) 字节：捕获一个 shared_ptr 再加几个指针、整数的 lambda，
+ *   或者 std::bind(&X::f, shared_from_this(), ...) 都放得下，不用堆分配
+ *   (libstdc++ 的 std::function 只有 16 字节，超过就 new)；
+ * - 放不下、或者移动构造可能抛异常的对象才放到堆上；
+ * - 只能移动，所以可以捕获 unique_ptr 之类只能移动的对象；
+ * - 和 std::function 一样，空对象或空的函数指针 / std::function 构造出来的是空的，调用空对象是未定义行为。
+ * operator() 是 const 的 (与 std::function 一致)，被调用对象本身不是 const。
+ */
+template<typename R, typename... Args, size_t InlineSize>
+class UniqueFunction<R(Args...), InlineSize>
+{
+public:
+    UniqueFunction() noexcept : m_ops(nullptr) {}
+    UniqueFunction(std::nullptr_t) noexcept : m_ops(nullptr) {}
+
+    template<typename F,
+             typename Fn = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same<Fn, UniqueFunction>::value &&
+                                         std::is_invocable_r<R, Fn&, Args...>::value>>
+    UniqueFunction(F&& f) : m_ops(nullptr)
+    {
+        if (isNull(f))
+        {
+            return;
+        }
+        if constexpr (fitsInline<Fn>())
+        {
+            new (m_storage) Fn(std::forward<F>(f));
+            m_ops = &InlineOps<Fn>::kOps;
+        }
+        else
+        {
+            *reinterpret_cast<Fn**>(m_storage) = new Fn(std::forward<F>(f));
+            m_ops = &HeapOps<Fn>::kOps;
+        }
+    }
+
+    UniqueFunction(UniqueFunction&& other) noexcept : m_ops(other.m_ops)
+    {
+        if (m_ops != nullptr)
+        {
+            m_ops->move(m_storage, other.m_storage);
+            other.m_ops = nullptr;
+        }
+    }
+
+    UniqueFunction& operator=(UniqueFunction&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            if (other.m_ops != nullptr)
+            {
+                other.m_ops->move(m_storage, other.m_storage);
+                m_ops = other.m_ops;
+                other.m_ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    UniqueFunction& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    template<typename F,
+             typename = std::enable_if_t<!std::is_same<std::decay_t<F>, UniqueFunction>::value>>
+    UniqueFunction& operator=(F&& f)
+    {
+        return *this = UniqueFunction(std::forward<F>(f));
+    }
+
+    UniqueFunction(const UniqueFunction&) = delete;
+    UniqueFunction& operator=(const UniqueFunction&) = delete;
+
+    ~UniqueFunction() { reset(); }
+
+    explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+    R operator()(Args... args) const
+    {
+        return m_ops->invoke(const_cast<unsigned char*>(m_storage), std::forward<Args>(args)...);
+    }
+
+    void swap(UniqueFunction& other) noexcept
+    {
+        UniqueFunction tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    struct Ops
+    {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*move)(void* dst, void* src) noexcept; // 移动到 dst 并销毁 src 中的对象
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template<typename Fn>
+    static constexpr bool fitsInline()
+    {
+        return sizeof(Fn) <= InlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+    template<typename Fn>
+    static R call(Fn& fn, Args&&... args)
+    {
+        if constexpr (std::is_void<R>::value)
+        {
+            std::invoke(fn, std::forward<Args>(args)...);
+        }
+        else
+        {
+            return std::invoke(fn, std::forward<Args>(args)...);
+        }
+    }
+
+    // 对象直接放在 m_storage 里
+    template<typename Fn>
+    struct InlineOps
+    {
+        static R invoke(void* storage, Args&&... args)
+        {
+            return call(*static_cast<Fn*>(storage), std::forward<Args>(args)...);
+        }
+        static void move(void* dst, void* src) noexcept
+        {
+            Fn* from = static_cast<Fn*>(src);
+            new (dst) Fn(std::move(*from));
+            from->~Fn();
+        }
+        static void destroy(void* storage) noexcept { static_cast<Fn*>(storage)->~Fn(); }
+        static constexpr Ops kOps = {&invoke, &move, &destroy};
+    };
+
+    // m_storage 里只放一个指向堆上对象的指针，移动时只搬指针
+    template<typename Fn>
+    struct HeapOps
+    {
+        static Fn*& ptr(void* storage) { return *static_cast<Fn**>(storage); }
+        static R invoke(void* storage, Args&&... args)
+        {
+            return call(*ptr(storage), std::forward<Args>(args)...);
+        }
+        static void move(void* dst, void* src) noexcept
+        {
+            ptr(dst) = ptr(src);
+            ptr(src) = nullptr;
+        }
+        static void destroy(void* storage) noexcept { delete ptr(storage); }
+        static constexpr Ops kOps = {&invoke, &move, &destroy};
+    };
+
+    template<typename F>
+    static bool isNull(const F&) { return false; }
+    template<typename T>
+    static bool isNull(T* ptr) { return ptr == nullptr; }
+    template<typename C, typename M>
+    static bool isNull(M C::*ptr) { return ptr == nullptr; }
+    template<typename S>
+    static bool isNull(const std::function<S>& fn) { return !fn; }
+
+    void reset() noexcept
+    {
+        if (m_ops != nullptr)
+        {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[InlineSize];
+    const Ops* m_ops;
+};
+
+#endif
@@ -0,0 +1,241 @@
+// base/WorkStealingPool.cpp
+
+#include "WorkStealingPool.h"
+#include "Logger.h"
+#include "CurrentThread.h"
+#include "Futex.h"
+
+#include <climits>
+#include <thread>
+
+namespace
+{
+
+// 当前线程所属的池和它在池中的下标，用于把 worker 自己提交的任务放进本地队列
+thread_local WorkStealingPool* t_pool = nullptr;
+thread_local int t_workerIndex = -1;
+
+// 防止漏掉唤醒的兜底：即使错过也最多睡这么久
+const long kParkTimeoutNs = 100 * 1000 * 1000;
+
+uint32_t xorshift(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(int threadNum, const std::string& name)
+    : m_name(name),
+      m_threadNum(threadNum),
+      m_injectedCount(0),
+      m_wakeEpoch(0),
+      m_sleepers(0),
+      m_stopping(false),
+      m_started(false)
+{}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    shutdown();
+}
+
+void WorkStealingPool::start()
+{
+    m_started = true;
+    m_stopping = false;
+    m_workers.clear();
+    for (int i = 0; i < m_threadNum; ++i)
+    {
+        m_workers.emplace_back(new Worker);
+        m_workers.back()->rng = static_cast<uint32_t>(i) * 2654435761u + 1;
+    }
+    m_threads.reserve(m_threadNum);
+    for (int i = 0; i < m_threadNum; ++i)
+    {
+        m_threads.emplace_back(std::make_unique<Thread>(
+            [this, i]() { threadFunc(i); },
+            m_name + std::to_string(i)
+        ));
+        m_threads[i]->start();
+    }
+}
+
+void WorkStealingPool::addTask(Task task)
+{
+    if (t_pool == this)
+    {
+        // worker 执行中派生的任务在关闭时也要执行完
+        m_workers[t_workerIndex]->deque.push(new Task(std::move(task)));
+    }
+    else
+    {
+        if (m_stopping.load(std::memory_order_relaxed))
+        {
+            return; // 与 ThreadPool 一致：关闭后不再接受外部任务
+        }
+        Task* item = new Task(std::move(task));
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        m_injected.push_back(item);
+        m_injectedCount.store(m_injected.size(), std::memory_order_relaxed);
+    }
+    // 与 park 中 "先登记休眠者再复查队列" 配对：要么 worker 复查时看到任务，要么这里看到休眠者
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_relaxed) > 0)
+    {
+        wakeOne();
+    }
+}
+
+WorkStealingPool::Task* WorkStealingPool::popInjected()
+{
+    if (m_injectedCount.load(std::memory_order_relaxed) == 0)
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_injectMutex);
+    if (m_injected.empty())
+    {
+        return nullptr;
+    }
+    Task* item = m_injected.front();
+    m_injected.pop_front();
+    m_injectedCount.store(m_injected.size(), std::memory_order_relaxed);
+    return item;
+}
+
+WorkStealingPool::Task* WorkStealingPool::findTask(int index)
+{
+    Worker& self = *m_workers[index];
+    if (Task* item = self.deque.take())
+    {
+        return item;
+    }
+    if (Task* item = popInjected())
+    {
+        return item;
+    }
+    // 从随机位置开始依次尝试偷每个 worker，避免所有空闲 worker 同时盯住同一个
+    int start = static_cast<int>(xorshift(self.rng) % static_cast<uint32_t>(m_threadNum));
+    for (int i = 0; i < m_threadNum; ++i)
+    {
+        int victim = (start + i) % m_threadNum;
+        if (victim == index)
+        {
+            continue;
+        }
+        if (Task* item = m_workers[victim]->deque.steal())
+        {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+bool WorkStealingPool::hasWork()
+{
+    if (m_injectedCount.load(std::memory_order_relaxed) > 0)
+    {
+        return true;
+    }
+    for (const auto& worker : m_workers)
+    {
+        if (!worker->deque.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::park()
+{
+    uint32_t epoch = m_wakeEpoch.load(std::memory_order_acquire);
+    m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+    // hasWork() 里都是 relaxed 读：与 submit 里的 fence 配对，否则这些读可以提前到登记休眠者之前
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!hasWork() && !m_stopping.load())
+    {
+        struct timespec timeout = {0, kParkTimeoutNs};
+        futexWait(&m_wakeEpoch, epoch, &timeout);
+    }
+    m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void WorkStealingPool::wakeOne()
+{
+    m_wakeEpoch.fetch_add(1, std::memory_order_release);
+    futexWake(&m_wakeEpoch, 1);
+}
+
+void WorkStealingPool::wakeAll()
+{
+    m_wakeEpoch.fetch_add(1, std::memory_order_release);
+    futexWake(&m_wakeEpoch, INT_MAX);
+}
+
+void WorkStealingPool::threadFunc(int index)
+{
+    t_pool = this;
+    t_workerIndex = index;
+    LOG_INFO << "Work-stealing worker started in thread " << CurrentThread::tid();
+
+    int idleRounds = 0;
+    while (true)
+    {
+        if (Task* item = findTask(index))
+        {
+            idleRounds = 0;
+            if (*item)
+            {
+                (*item)();
+            }
+            delete item;
+            continue;
+        }
+        // 正在关闭且所有队列都空了才退出；其它 worker 正在执行的任务派生的子任务会留给它自己执行
+        if (m_stopping.load() && !hasWork())
+        {
+            break;
+        }
+        if (++idleRounds < kSpinRounds)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        park();
+        idleRounds = 0;
+    }
+
+    t_pool = nullptr;
+    t_workerIndex = -1;
+    LOG_INFO << "Work-stealing worker exited.";
+}
+
+void WorkStealingPool::shutdown()
+{
+    if (!m_started)
+    {
+        return;
+    }
+    LOG_INFO << "WorkStealingPool is shutting down...";
+    m_stopping.store(true);
+    wakeAll();
+    for (auto& thread : m_threads)
+    {
+        thread->join();
+    }
+    m_threads.clear();
+
+    // 关闭过程中从外部提交、已经进了注入队列的任务
+    for (Task* item : m_injected)
+    {
+        delete item;
+    }
+    m_injected.clear();
+    m_injectedCount.store(0);
+    m_started = false;
+}
@@ -0,0 +1,74 @@
+// base/WorkStealingPool.h
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include "noncopyable.h"
+#include "Thread.h"
+#include "ChaseLevDeque.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 工作窃取线程池，接口与 ThreadPool 相同。
+ * - 每个 worker 一个 Chase-Lev 双端队列：worker 自己提交的任务压进自己的队列，后进先出，不加锁；
+ * - 外部线程提交的任务进共享的注入队列 (一把锁，只有外部提交者和本地空了的 worker 会碰)；
+ * - worker 本地队列空了先查注入队列，再随机挑一个 worker 偷最旧的任务；
+ * - 找不到任务时先自旋几轮，再在 futex 上休眠；提交者只有在有 worker 休眠时才执行 futex 唤醒。
+ * 适合大量细粒度任务，尤其是任务在执行中继续派生子任务 (fork-join) 的场景。
+ */
+class WorkStealingPool : noncopyable
+{
+public:
+    using Task = std::function<void()>;
+
+    WorkStealingPool(int threadNum, const std::string& name = std::string("WorkStealingPool"));
+    ~WorkStealingPool();
+
+    void start();
+
+    // 任意线程可调用；在本池的 worker 中调用时进入该 worker 的本地队列
+    void addTask(Task task);
+
+    // 执行完所有已提交的任务 (包括执行中派生的) 后返回，之后提交的任务被丢弃
+    void shutdown();
+
+private:
+    struct Worker
+    {
+        ChaseLevDeque<Task> deque;
+        uint32_t rng; // 选择窃取对象的 xorshift 状态
+    };
+
+    static const int kSpinRounds = 64; // 休眠前找任务的轮数
+
+    void threadFunc(int index);
+    Task* findTask(int index);
+    Task* popInjected();
+    bool hasWork();
+    void park();
+    void wakeOne();
+    void wakeAll();
+
+    std::string m_name;
+    int m_threadNum;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::unique_ptr<Thread>> m_threads;
+
+    std::mutex m_injectMutex;
+    std::deque<Task*> m_injected;                 // 外部提交的任务
+    std::atomic<size_t> m_injectedCount;          // 不加锁判断注入队列是否为空
+
+    std::atomic<uint32_t> m_wakeEpoch;            // futex 字：每次唤醒加一
+    std::atomic<int> m_sleepers;                  // 正在 (或即将) 休眠的 worker 数
+    std::atomic<bool> m_stopping;
+    std::atomic_bool m_started;
+};
+
+#endif
@@ -0,0 +1,63 @@
+// examples/hot_restart_server.cpp
+// 热重启演示：同一个命令启动两次，第二个进程会接管第一个进程的监听 socket 和空闲连接
+//
+//   终端1: ./hot_restart_server 8000 /tmp/my_muduo_hot_restart.sock
+//   终端2: nc 127.0.0.1 8000        (输入几行，保持连接不断开)
+//   终端3: ./hot_restart_server 8000 /tmp/my_muduo_hot_restart.sock
+// 终端1 的进程交出 fd 后退出，终端2 里的 nc 继续输入，回显来自新进程 (pid 会变)
+
+#include "net/TcpServer.h"
+#include "net/TcpConnection.h"
+#include "net/EventLoop.h"
+#include "net/InetAddress.h"
+#include "net/HotRestart.h"
+#include "net/Buffer.h"
+#include "base/Logger.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+int main(int argc, char* argv[])
+{
+    uint16_t port = argc > 1 ? static_cast<uint16_t>(atoi(argv[1])) : 8000;
+    std::string path = argc > 2 ? argv[2] : "/tmp/my_muduo_hot_restart.sock";
+
+    EventLoop loop;
+
+    // 先尝试接管正在运行的旧进程，没有的话就正常冷启动
+    HotRestart::Inherited inherited = HotRestart::takeover(path);
+    std::unique_ptr<TcpServer> server;
+    if (inherited.ok())
+    {
+        server.reset(new TcpServer(&loop, inherited.listenFds[0], "HotRestartServer"));
+    }
+    else
+    {
+        server.reset(new TcpServer(&loop, InetAddress(port), "HotRestartServer"));
+    }
+
+    const std::string pid = std::to_string(::getpid());
+    server->setConnectionCallback([pid](const TcpConnectionPtr& conn) {
+        LOG_INFO << "[pid " << pid << "] " << conn->peerAddress().toIpPort()
+                 << (conn->connected() ? " UP" : " DOWN");
+    });
+    server->setMessageCallback([pid](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        conn->send("[pid " + pid + "] " + buf->retrieveAllAsString());
+    });
+    server->setThreadNum(2);
+    server->start();
+
+    for (int fd : inherited.connFds)
+    {
+        server->adoptConnection(fd);
+    }
+
+    // 为下一代进程做好准备；交接完成、旧连接排空后 loop 自动退出
+    server->enableHotRestart(path);
+
+    loop.loop();
+    LOG_INFO << "[pid " << pid << "] exits";
+    return 0;
+}
@@ -35,6 +35,15 @@ Acceptor::Acceptor(EventLoop* loop, const InetAddress& listenAddr, bool reusepor
     m_acceptChannel.setReadCallback(std::bind(&Acceptor::handleRead, this));
 }
 
+Acceptor::Acceptor(EventLoop* loop, int listenFd)
+    : m_loop(loop),
+      m_acceptSocket(listenFd),
+      m_acceptChannel(loop, listenFd),
+      m_listening(false)
+{
+    m_acceptChannel.setReadCallback(std::bind(&Acceptor::handleRead, this));
+}
+
 Acceptor::~Acceptor()
 {
     // 在析构时，确保 Channel 不再监听任何事件，并从 Poller 中移除
@@ -51,6 +60,14 @@ void Acceptor::listen()
     m_acceptChannel.enableReading();  // 将 Channel 注册到 Poller 中，开始监听读事件
 }
 
+void Acceptor::stopListening()
+{
+    m_loop->assertInLoopThread();
+    m_listening = false;
+    // 只是不再关注读事件，已在 backlog 中排队的连接留给接管监听 fd 的进程
+    m_acceptChannel.disableAll();
+}
+
 // listenfd 有事件发生了，就是有新用户连接了
 void Acceptor::handleRead()
 {
@@ -73,7 +90,8 @@ void Acceptor::handleRead()
     }
     else
     {
-        LOG_ERROR << "accept err:" << errno;
+        // 【修改】fd 耗尽 (EMFILE) 时每次唤醒都会失败，限流避免日志风暴拖住 IO 线程
+        LOG_RATE_LIMITED(ERROR, 10) << "accept err:" << errno;
         // 这里的错误可能是 fd 耗尽，需要处理
     }
 }
\ No newline at end of file
@@ -21,6 +21,8 @@ public:
     using NewConnectionCallback = std::function<void(int sockfd, const InetAddress&)>;
 
     Acceptor(EventLoop* loop, const InetAddress& listenAddr, bool reuseport);
+    // 热重启：接管从旧进程继承来的、已经 bind 好的监听 fd
+    Acceptor(EventLoop* loop, int listenFd);
     ~Acceptor();
 
     // 设置新连接到来的回调函数
@@ -31,6 +33,10 @@ public:
 
     bool listening() const { return m_listening; }
     void listen();
+    // 不再 accept 新连接，但监听 socket 保持打开 (热重启时交给新进程)
+    void stopListening();
+
+    int fd() const { return m_acceptSocket.fd(); }
 
 private:
     // 当 m_acceptChannel 上的 fd 有可读事件（新连接）时被调用
@@ -3,6 +3,8 @@
 #ifndef CALLBACKS_H
 #define CALLBACKS_H
 
+#include "base/UniqueFunction.h"
+
 #include <functional>
 #include <memory>
 
@@ -21,6 +23,7 @@ using MessageCallback = std::function<void(const TcpConnectionPtr&,
                                            Buffer*,
                                            Timestamp)>;
                                            
-using TimerCallback = std::function<void()>;
+// 【修改】只在一个 Timer 里保存、只会被移动，用 UniqueFunction 避免捕获较多时的堆分配
+using TimerCallback = UniqueFunction<void()>;
 
 #endif
\ No newline at end of file
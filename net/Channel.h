@@ -3,6 +3,7 @@
 
 #include "base/noncopyable.h"
 #include "base/Timestamp.h"
+#include "base/UniqueFunction.h"
 #include <functional>
 #include <memory>
 
@@ -11,18 +12,19 @@ class EventLoop;
 class Channel : noncopyable
 {
 public:
-    using EventCallback = std::function<void()>;
-    using ReadEventCallback = std::function<void(Timestamp)>;
+    // 【修改】回调只由 Channel 保存，用只能移动的 UniqueFunction，bind 一个 shared_ptr 也不用堆分配
+    using EventCallback = UniqueFunction<void()>;
+    using ReadEventCallback = UniqueFunction<void(Timestamp)>;
 
     Channel(EventLoop* loop, int fd);
     ~Channel();
 
     void handleEvent(Timestamp receiveTime);
 
-    void setReadCallback(const ReadEventCallback& cb) { m_readCallback = cb; }
-    void setWriteCallback(const EventCallback& cb) { m_writeCallback = cb; }
-    void setCloseCallback(const EventCallback& cb) { m_closeCallback = cb; }
-    void setErrorCallback(const EventCallback& cb) { m_errorCallback = cb; }
+    void setReadCallback(ReadEventCallback cb) { m_readCallback = std::move(cb); }
+    void setWriteCallback(EventCallback cb) { m_writeCallback = std::move(cb); }
+    void setCloseCallback(EventCallback cb) { m_closeCallback = std::move(cb); }
+    void setErrorCallback(EventCallback cb) { m_errorCallback = std::move(cb); }
 
     //将 Channel 绑定到一个对象上，防止在 handleEvent 中对象被销毁
     void tie(const std::shared_ptr<void>&);
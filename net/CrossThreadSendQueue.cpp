@@ -0,0 +1,110 @@
+// net/CrossThreadSendQueue.cpp
+
+#include "CrossThreadSendQueue.h"
+#include "EventLoop.h"
+#include "TcpConnection.h"
+
+#include <unordered_map>
+
+CrossThreadSendQueue::CrossThreadSendQueue(EventLoop* loop)
+    : m_loop(loop),
+      m_ring(kRingCapacity),
+      m_drainScheduled(false),
+      m_overflowing(false)
+{}
+
+CrossThreadSendQueue* CrossThreadSendQueue::forLoop(EventLoop* loop)
+{
+    // 每个生产者线程一张表；队列由表和 loop 中排队的 drain 共同持有，线程退出后排队中的消息照样发出
+    struct Entry
+    {
+        std::weak_ptr<void> loopLifetime;
+        std::shared_ptr<CrossThreadSendQueue> queue;
+    };
+    thread_local std::unordered_map<EventLoop*, Entry> t_queues;
+    auto it = t_queues.find(loop);
+    if (it != t_queues.end() && !it->second.loopLifetime.expired())
+    {
+        return it->second.queue.get();
+    }
+
+    // 第一次投递到这个 loop，或者缓存的是同一地址上已经析构的旧 loop：
+    // 清掉所有已析构 loop 的队列 (连同各自的环)，再为它新建一个
+    for (it = t_queues.begin(); it != t_queues.end();)
+    {
+        if (it->second.loopLifetime.expired())
+        {
+            it = t_queues.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    Entry& entry = t_queues[loop];
+    entry.loopLifetime = loop->lifetime();
+    entry.queue = std::make_shared<CrossThreadSendQueue>(loop);
+    return entry.queue.get();
+}
+
+void CrossThreadSendQueue::push(const TcpConnectionPtr& conn, std::string&& data)
+{
+    PendingSend item{conn, std::move(data)};
+    // 只有本线程会置位 m_overflowing，读到 false 说明溢出队列确实是空的
+    if (m_overflowing.load(std::memory_order_acquire) || !m_ring.TryPush(std::move(item)))
+    {
+        // 环满说明 IO 线程落后了；不能原地等它 (两个 IO 线程互相发送时会死锁)，放进溢出队列
+        std::lock_guard<std::mutex> lock(m_overflowMutex);
+        m_overflow.push_back(std::move(item));
+        m_overflowing.store(true, std::memory_order_release);
+    }
+    scheduleDrain();
+}
+
+void CrossThreadSendQueue::scheduleDrain()
+{
+    // 只有从 false 变成 true 的那一次需要投递 drain，同一批后续的 push 不再加锁和唤醒
+    if (!m_drainScheduled.exchange(true, std::memory_order_acq_rel))
+    {
+        m_loop->queueInLoop(std::bind(&CrossThreadSendQueue::drain, shared_from_this()));
+    }
+}
+
+void CrossThreadSendQueue::drain()
+{
+    m_loop->assertInLoopThread();
+    // 先清标志再取数据：清除之后 push 进来的消息一定会触发新的 drain，不会丢
+    // 用 exchange (读-改-写) 与生产者的 exchange 同步，保证看得到之前 push 的元素
+    m_drainScheduled.exchange(false, std::memory_order_acq_rel);
+
+    drainRing();
+
+    std::deque<PendingSend> overflow;
+    {
+        std::lock_guard<std::mutex> lock(m_overflowMutex);
+        if (m_overflow.empty())
+        {
+            m_overflowing.store(false, std::memory_order_release);
+            return;
+        }
+        overflow.swap(m_overflow);
+    }
+    // m_overflowing 仍然置位，环里剩下的都是溢出之前放入的，先发它们
+    drainRing();
+    for (PendingSend& item : overflow)
+    {
+        item.conn->sendInLoop(item.data.data(), item.data.size());
+    }
+    // 再排一次 drain，由它确认溢出队列已空后让生产者回到环上；生产者一直很快时也不会独占这一轮
+    scheduleDrain();
+}
+
+void CrossThreadSendQueue::drainRing()
+{
+    PendingSend item;
+    while (m_ring.TryPop(item))
+    {
+        item.conn->sendInLoop(item.data.data(), item.data.size());
+        item.conn.reset();
+    }
+}
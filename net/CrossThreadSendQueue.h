@@ -0,0 +1,64 @@
+// net/CrossThreadSendQueue.h
+
+#ifndef CROSSTHREADSENDQUEUE_H
+#define CROSSTHREADSENDQUEUE_H
+
+#include "base/noncopyable.h"
+#include "base/SpscQueue.h"
+#include "Callbacks.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class EventLoop;
+
+/**
+ * @brief 从非 IO 线程 (例如 ThreadPool 的 worker) 向某个 EventLoop 批量投递 send。
+ * 每个 (生产者线程, EventLoop) 对应一个 SPSC 环形队列：
+ * - 生产者把 (连接, 数据) 放进环里，只有环由"空闲"变为"待处理"时才 queueInLoop + wakeup 一次；
+ * - IO 线程在一个 pending functor 里把环一次性取空，逐条调用 sendInLoop。
+ * 这样每批消息只有一次加锁和一次 eventfd 写，而不是每条消息一次 std::bind + 加锁 + wakeup。
+ * 环满时不等待 (生产者可能本身就是 IO 线程，互相等待会死锁)，改放进加锁的溢出队列；
+ * 溢出队列非空期间新消息也排在它后面，同一线程发出的消息顺序不变。
+ */
+class CrossThreadSendQueue : noncopyable, public std::enable_shared_from_this<CrossThreadSendQueue>
+{
+public:
+    explicit CrossThreadSendQueue(EventLoop* loop);
+
+    // 返回当前线程投递到 loop 的队列 (线程局部，首次使用时创建)；
+    // 缓存里已经析构的 loop 的队列在下一次创建队列时一并清掉
+    static CrossThreadSendQueue* forLoop(EventLoop* loop);
+
+    // 生产者线程调用，从不阻塞
+    void push(const TcpConnectionPtr& conn, std::string&& data);
+
+private:
+    struct PendingSend
+    {
+        TcpConnectionPtr conn;
+        std::string data;
+    };
+
+    // 每个环的容量，按元素约 48 字节计算，每个 (线程, loop) 约占 48KB
+    static const size_t kRingCapacity = 1024;
+
+    void scheduleDrain();
+    void drain(); // IO 线程
+    void drainRing();
+
+    EventLoop* m_loop;
+    SpscQueue<PendingSend> m_ring;
+    std::atomic<bool> m_drainScheduled; // 已经有一个 drain 在 loop 的 pending functor 中
+
+    // 环满之后的消息。m_overflowing 由生产者在放入时置位、由 drain 确认溢出队列已空时清除，
+    // 两者都在 m_overflowMutex 内修改；置位期间生产者不再碰环，环里的消息都排在溢出队列之前
+    std::mutex m_overflowMutex;
+    std::deque<PendingSend> m_overflow;
+    std::atomic<bool> m_overflowing;
+};
+
+#endif
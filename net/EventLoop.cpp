@@ -31,7 +31,9 @@ EventLoop::EventLoop()
       m_poller(Poller::newDefaultPoller(this)),
       m_timerQueue(new TimerQueue(this)),
       m_wakeupFd(createEventfd()),
-      m_wakeupChannel(std::make_unique<Channel>(this, m_wakeupFd))
+      m_wakeupChannel(std::make_unique<Channel>(this, m_wakeupFd)),
+      m_eventHandling(false),
+      m_lifetime(std::make_shared<char>(0))
 {
     if (t_loopInThisThread)
     {
@@ -50,6 +52,7 @@ EventLoop::EventLoop()
 
 EventLoop::~EventLoop()
 {
+    m_lifetime.reset();
     m_wakeupChannel->disableAll();
     m_wakeupChannel->remove();
     ::close(m_wakeupFd);
@@ -66,13 +69,21 @@ void EventLoop::loop()
     while (!m_quit)
     {
         m_activeChannels.clear();
-        m_poller->poll(kPollTimeMs, &m_activeChannels);
+        // 堆顶是 slack 定时器时由 poll 超时唤醒，不经过 timerfd
+        m_pollReturnTime = m_poller->poll(m_timerQueue->pollTimeout(kPollTimeMs), &m_activeChannels);
+        m_pollReturnMonoTime = MonoTime::now();
 
+        // 同一批活跃事件共用 poll 返回的时间，不必每个 channel 都读一次时钟
+        m_eventHandling = true;
         for (Channel* channel : m_activeChannels)
         {
-            channel->handleEvent(Timestamp::now());
+            channel->handleEvent(m_pollReturnTime);
         }
-        
+        // 触发窗口已经打开的定时器 (timerfd 可读时已在上面处理过，这里通常是 slack 定时器)
+        m_timerQueue->processExpired(m_pollReturnMonoTime);
+        m_eventHandling = false;
+
+        doAfterEventsFunctors();
         doPendingFunctors();
     }
     LOG_INFO << "EventLoop " << this << " stop looping.";
@@ -88,7 +99,7 @@ void EventLoop::quit()
     }
 }
 
-void EventLoop::runInLoop(std::function<void()> cb)
+void EventLoop::runInLoop(Functor cb)
 {
     if (isInLoopThread())
     {
@@ -96,15 +107,15 @@ void EventLoop::runInLoop(std::function<void()> cb)
     }
     else
     {
-        queueInLoop(cb);
+        queueInLoop(std::move(cb));
     }
 }
 
-void EventLoop::queueInLoop(std::function<void()> cb)
+void EventLoop::queueInLoop(Functor cb)
 {
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_pendingFunctors.push_back(cb);
+        m_pendingFunctors.push_back(std::move(cb));
     }
 
     if (!isInLoopThread() || m_callingPendingFunctors)
@@ -113,6 +124,34 @@ void EventLoop::queueInLoop(std::function<void()> cb)
     }
 }
 
+void EventLoop::queueCompletion(Completion* completion)
+{
+    if (m_completions.push(completion))
+    {
+        queueInLoop([this]() { m_completions.drain(); });
+    }
+}
+
+void EventLoop::queueAfterEvents(Functor cb)
+{
+    assertInLoopThread();
+    m_afterEventsFunctors.push_back(std::move(cb));
+}
+
+void EventLoop::doAfterEventsFunctors()
+{
+    if (m_afterEventsFunctors.empty())
+    {
+        return;
+    }
+    std::vector<Functor> functors;
+    functors.swap(m_afterEventsFunctors);
+    for (const auto& functor : functors)
+    {
+        functor();
+    }
+}
+
 void EventLoop::wakeup()
 {
     uint64_t one = 1;
@@ -135,18 +174,20 @@ void EventLoop::handleRead()
 
 void EventLoop::doPendingFunctors()
 {
-    std::vector<std::function<void()>> functors;
     m_callingPendingFunctors = true;
 
+    // 【修改】换出来的 vector 执行完后 clear 但保留容量，下一次交换还给 m_pendingFunctors，
+    // 稳定之后 queueInLoop 的 push_back 不再扩容
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        functors.swap(m_pendingFunctors);
+        m_runningFunctors.swap(m_pendingFunctors);
     }
 
-    for (const auto& functor : functors)
+    for (const auto& functor : m_runningFunctors)
     {
         functor();
     }
+    m_runningFunctors.clear();
     m_callingPendingFunctors = false;
 }
 
@@ -177,21 +218,28 @@ void EventLoop::abortNotInLoopThread()
 
 // --- 【新增】定时器接口实现 ---
 
-TimerId EventLoop::runAt(Timestamp time, TimerCallback cb)
+TimerId EventLoop::runAt(Timestamp time, TimerCallback cb, double slack)
+{
+    int64_t delayUs = time.microSecondsSinceEpoch() - Timestamp::now().microSecondsSinceEpoch();
+    MonoTime when(MonoTime::now().nanoSeconds() + delayUs * MonoTime::kNanoSecondsPerMicroSecond);
+    return runAt(when, std::move(cb), slack);
+}
+
+TimerId EventLoop::runAt(MonoTime time, TimerCallback cb, double slack)
 {
-    return m_timerQueue->addTimer(std::move(cb), time, 0.0);
+    return m_timerQueue->addTimer(std::move(cb), time, 0.0, slack);
 }
 
-TimerId EventLoop::runAfter(double delay, TimerCallback cb)
+TimerId EventLoop::runAfter(double delay, TimerCallback cb, double slack)
 {
-    Timestamp time(addTime(Timestamp::now(), delay));
-    return runAt(time, std::move(cb));
+    MonoTime time(addTime(MonoTime::now(), delay));
+    return runAt(time, std::move(cb), slack);
 }
 
-TimerId EventLoop::runEvery(double interval, TimerCallback cb)
+TimerId EventLoop::runEvery(double interval, TimerCallback cb, double slack)
 {
-    Timestamp time(addTime(Timestamp::now(), interval));
-    return m_timerQueue->addTimer(std::move(cb), time, interval);
+    MonoTime time(addTime(MonoTime::now(), interval));
+    return m_timerQueue->addTimer(std::move(cb), time, interval, slack);
 }
 
 void EventLoop::cancel(TimerId timerId)
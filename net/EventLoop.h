@@ -6,6 +6,8 @@
 #include "base/noncopyable.h"
 #include "base/CurrentThread.h"
 #include "base/Timestamp.h"
+#include "base/MonoTime.h"
+#include "base/TaskFuture.h"
 #include "TimerId.h"
 #include "net/Callbacks.h"
 
@@ -23,7 +25,9 @@ class TimerQueue;
 class EventLoop : noncopyable
 {
 public:
-    using Functor = std::function<void()>;
+    // 【修改】跨线程投递的回调只会被移动，用 UniqueFunction：捕获一个 shared_ptr 加几个参数也放在内联缓冲里，
+    // 投递路径上不再为回调分配内存
+    using Functor = UniqueFunction<void()>;
 
     EventLoop();
     ~EventLoop();
@@ -32,18 +36,35 @@ public:
     void quit();
 
     Timestamp pollReturnTime() const { return m_pollReturnTime; }
+    // 【新增】poll 返回时的单调时间，用于定时器和延迟/空闲计算，同一轮事件共用，不必重复读时钟
+    MonoTime pollReturnMonoTime() const { return m_pollReturnMonoTime; }
 
     void runInLoop(Functor cb);
     void queueInLoop(Functor cb);
     void wakeup();
 
+    // 【新增】任意线程：在 loop 线程上执行 completion->complete() (ThreadPool::submit(...).then 使用)。
+    // 不加锁地挂到完成队列上；只有队列由空变为非空的那一次才占用一个 pending functor，
+    // 同一轮里到达的其它完成通知由它成批执行
+    void queueCompletion(Completion* completion);
+
+    // 只能在 loop 线程调用：本轮活跃 channel 全部处理完之后、doPendingFunctors 之前执行
+    // 用于把一轮事件处理中产生的多次写合并成一次 (TcpConnection 的 auto-cork)
+    void queueAfterEvents(Functor cb);
+    // 当前是否正在处理活跃 channel (包括其中触发的定时器回调)
+    bool eventHandling() const { return m_eventHandling; }
+
     // --- 【新增】定时器相关接口 ---
+    // slack (秒)：允许推迟触发的时长。不小于 1ms 时由 poll 超时驱动且与相邻定时器合并触发，
+    // 适合心跳、空闲检测这类不要求精确的定时器；默认 0 表示精确定时 (timerfd)
     // 在指定的时间点执行
-    TimerId runAt(Timestamp time, TimerCallback cb);
+    // 【修改】定时器内部使用单调时钟；传入墙上时间时在调用处换算一次，此后系统时间跳变不再影响它
+    TimerId runAt(Timestamp time, TimerCallback cb, double slack = 0.0);
+    TimerId runAt(MonoTime time, TimerCallback cb, double slack = 0.0);
     // 在一段时间后执行
-    TimerId runAfter(double delay, TimerCallback cb);
+    TimerId runAfter(double delay, TimerCallback cb, double slack = 0.0);
     // 每隔一段时间执行
-    TimerId runEvery(double interval, TimerCallback cb);
+    TimerId runEvery(double interval, TimerCallback cb, double slack = 0.0);
     // 取消定时器
     void cancel(TimerId timerId);
     // ---------------------------
@@ -52,6 +73,10 @@ public:
     void removeChannel(Channel* channel);
     bool hasChannel(Channel* channel);
 
+    // 【新增】loop 析构时失效。以 EventLoop* 为键缓存的对象 (CrossThreadSendQueue) 用它识别已经析构的 loop，
+    // 之后的新 loop 复用了同一个地址也不会拿到旧的缓存
+    std::weak_ptr<void> lifetime() const { return m_lifetime; }
+
     bool isInLoopThread() const { return m_threadId == CurrentThread::tid(); }
     void assertInLoopThread()
     {
@@ -65,6 +90,7 @@ private:
     void abortNotInLoopThread();
     void handleRead(); 
     void doPendingFunctors();
+    void doAfterEventsFunctors();
 
     using ChannelList = std::vector<Channel*>;
 
@@ -72,6 +98,7 @@ private:
     std::atomic_bool m_quit;
     const pid_t m_threadId;
     Timestamp m_pollReturnTime;
+    MonoTime m_pollReturnMonoTime;
 
     std::unique_ptr<Poller> m_poller;
     // 【新增】定时器队列管理，EventLoop 拥有它
@@ -80,10 +107,17 @@ private:
     int m_wakeupFd;
     std::unique_ptr<Channel> m_wakeupChannel;
     ChannelList m_activeChannels;
+    bool m_eventHandling;
+    std::vector<Functor> m_afterEventsFunctors; // 只在 loop 线程访问，不需要加锁
+
+    CompletionQueue m_completions;
 
     std::atomic_bool m_callingPendingFunctors;
     std::vector<Functor> m_pendingFunctors;
+    std::vector<Functor> m_runningFunctors; // doPendingFunctors 与 m_pendingFunctors 交换，两个 vector 的容量轮流复用
     std::mutex m_mutex;
+
+    std::shared_ptr<void> m_lifetime;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,256 @@
+// net/HotRestart.cpp
+
+#include "HotRestart.h"
+#include "base/Logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+
+bool fillUnixAddr(const std::string& path, sockaddr_un* addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr->sun_path))
+    {
+        LOG_ERROR << "HotRestart: unix socket path too long: " << path;
+        return false;
+    }
+    strncpy(addr->sun_path, path.c_str(), sizeof(addr->sun_path) - 1);
+    return true;
+}
+
+void setIoTimeout(int fd, int option, int seconds)
+{
+    timeval timeout = {seconds, 0};
+    if (::setsockopt(fd, SOL_SOCKET, option, &timeout, sizeof(timeout)) < 0)
+    {
+        LOG_ERROR << "HotRestart: setsockopt timeout err:" << errno;
+    }
+}
+
+} // namespace
+
+int HotRestart::listenUnix(const std::string& path)
+{
+    sockaddr_un addr;
+    if (!fillUnixAddr(path, &addr))
+    {
+        return -1;
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        LOG_ERROR << "HotRestart::listenUnix socket err:" << errno;
+        return -1;
+    }
+    ::unlink(path.c_str()); // 上一代进程留下的 socket 文件
+    if (::bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || ::listen(fd, 1) < 0)
+    {
+        LOG_ERROR << "HotRestart::listenUnix bind/listen " << path << " err:" << errno;
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int HotRestart::acceptPeer(int unixListenFd)
+{
+    // 不带 SOCK_NONBLOCK：消息都很小，在超时限制下阻塞地发完
+    int fd = ::accept4(unixListenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+        LOG_ERROR << "HotRestart::acceptPeer accept err:" << errno;
+        return -1;
+    }
+    ucred cred;
+    memset(&cred, 0, sizeof(cred));
+    socklen_t len = sizeof(cred);
+    if (::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) < 0 || cred.uid != ::geteuid())
+    {
+        LOG_ERROR << "HotRestart::acceptPeer rejected pid " << cred.pid << " uid " << cred.uid;
+        ::close(fd);
+        return -1;
+    }
+    setIoTimeout(fd, SO_SNDTIMEO, kIoTimeoutSeconds);
+    setIoTimeout(fd, SO_RCVTIMEO, kIoTimeoutSeconds);
+    return fd;
+}
+
+bool HotRestart::sendListenFds(int unixFd, const std::vector<int>& fds)
+{
+    return sendFds(unixFd, kListen, fds);
+}
+
+bool HotRestart::sendConnFds(int unixFd, const std::vector<int>& fds)
+{
+    return sendFds(unixFd, kConnection, fds);
+}
+
+bool HotRestart::sendDone(int unixFd)
+{
+    return sendMessage(unixFd, kDone, nullptr, 0);
+}
+
+bool HotRestart::sendFds(int unixFd, Kind kind, const std::vector<int>& fds)
+{
+    for (size_t i = 0; i < fds.size(); i += kMaxFdsPerMessage)
+    {
+        int count = static_cast<int>(std::min<size_t>(kMaxFdsPerMessage, fds.size() - i));
+        if (!sendMessage(unixFd, kind, fds.data() + i, count))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HotRestart::sendMessage(int unixFd, Kind kind, const int* fds, int count)
+{
+    Header header = { static_cast<uint32_t>(kind), static_cast<uint32_t>(count) };
+    iovec iov;
+    iov.iov_base = &header;
+    iov.iov_len = sizeof(header);
+
+    char control[CMSG_SPACE(sizeof(int) * kMaxFdsPerMessage)];
+    memset(control, 0, sizeof(control));
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (count > 0)
+    {
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * count);
+    }
+
+    ssize_t n;
+    do
+    {
+        n = ::sendmsg(unixFd, &msg, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+
+    if (n != static_cast<ssize_t>(sizeof(header)))
+    {
+        LOG_ERROR << "HotRestart::sendMessage err:" << errno;
+        return false;
+    }
+    return true;
+}
+
+HotRestart::Inherited HotRestart::takeover(const std::string& path)
+{
+    Inherited inherited;
+    sockaddr_un addr;
+    if (!fillUnixAddr(path, &addr))
+    {
+        return inherited;
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        LOG_ERROR << "HotRestart::takeover socket err:" << errno;
+        return inherited;
+    }
+    if (::connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0)
+    {
+        // 没有旧进程在运行，属于正常的冷启动
+        LOG_INFO << "HotRestart::takeover no running instance at " << path;
+        ::close(fd);
+        return inherited;
+    }
+    // 旧进程卡住时不要一直等下去：超时按连接断开处理，已经收到的监听 fd 照常使用
+    setIoTimeout(fd, SO_RCVTIMEO, kIoTimeoutSeconds);
+
+    bool done = false;
+    while (!done)
+    {
+        Header header;
+        iovec iov;
+        iov.iov_base = &header;
+        iov.iov_len = sizeof(header);
+
+        char control[CMSG_SPACE(sizeof(int) * kMaxFdsPerMessage)];
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        // MSG_CMSG_CLOEXEC: 收到的 fd 同样带上 close-on-exec
+        // O_NONBLOCK 属于 open file description，和旧进程共享，不需要重新设置
+        ssize_t n = ::recvmsg(fd, &msg, MSG_WAITALL | MSG_CMSG_CLOEXEC);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n != static_cast<ssize_t>(sizeof(header)))
+        {
+            LOG_ERROR << "HotRestart::takeover connection to old process broken, n=" << n;
+            break;
+        }
+
+        std::vector<int>* target = nullptr;
+        switch (header.kind)
+        {
+        case kListen:     target = &inherited.listenFds; break;
+        case kConnection: target = &inherited.connFds;   break;
+        case kDone:       done = true;                   break;
+        default:
+            LOG_ERROR << "HotRestart::takeover unknown message kind " << header.kind;
+            break;
+        }
+
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+            {
+                continue;
+            }
+            int count = static_cast<int>((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+            const int* received = reinterpret_cast<const int*>(CMSG_DATA(cmsg));
+            for (int i = 0; i < count; ++i)
+            {
+                if (target)
+                {
+                    target->push_back(received[i]);
+                }
+                else
+                {
+                    ::close(received[i]);
+                }
+            }
+        }
+    }
+    ::close(fd);
+
+    if (!done)
+    {
+        // 没有收到 kDone，旧进程会认为连接没交出去并自己继续处理，这里不能再用
+        for (int connFd : inherited.connFds)
+        {
+            ::close(connFd);
+        }
+        inherited.connFds.clear();
+    }
+
+    LOG_INFO << "HotRestart::takeover inherited " << inherited.listenFds.size()
+             << " listen fd(s) and " << inherited.connFds.size() << " connection(s)";
+    return inherited;
+}
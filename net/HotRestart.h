@@ -0,0 +1,65 @@
+// net/HotRestart.h
+
+#ifndef HOTRESTART_H
+#define HOTRESTART_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 热重启时在新旧进程之间传递 fd 的工具函数。
+ * 旧进程在一个 unix domain socket 上等待，新进程连上来之后，
+ * 旧进程通过 SCM_RIGHTS 把监听 fd (以及空闲的已建立连接 fd) 发过去，
+ * 内核会在新进程中 dup 出指向同一个 socket 的新 fd，监听队列和连接都不会断。
+ *
+ * 协议很简单：每条消息带一个 Header，再附带最多 kMaxFdsPerMessage 个 fd，
+ * 最后一条 kDone 消息表示传输结束；没有收到 kDone 时新进程丢弃已收到的连接 fd，
+ * 这些连接仍由旧进程处理。
+ */
+class HotRestart
+{
+public:
+    // 新进程拿到的全部 fd
+    struct Inherited
+    {
+        std::vector<int> listenFds;
+        std::vector<int> connFds;
+        bool ok() const { return !listenFds.empty(); }
+    };
+
+    // 旧进程：在 path 上创建 unix 监听 socket (非阻塞，交给 EventLoop 监听)
+    static int listenUnix(const std::string& path);
+
+    // 旧进程：接受新进程的连接。对端要拿走活跃连接的 fd，只接受与本进程 euid 相同的进程；
+    // 返回的 fd 是阻塞的，但收发都有 kIoTimeoutSeconds 的超时，对端卡住时不会一直占住 loop。
+    // 拒绝或出错时返回 -1
+    static int acceptPeer(int unixListenFd);
+
+    // 旧进程：把 fd 发给已经连上来的新进程 (阻塞写，受超时限制)
+    static bool sendListenFds(int unixFd, const std::vector<int>& fds);
+    static bool sendConnFds(int unixFd, const std::vector<int>& fds);
+    static bool sendDone(int unixFd);
+
+    // 新进程：连接旧进程，阻塞地收完所有 fd (每条消息最多等 kIoTimeoutSeconds)；没有旧进程时返回空的 Inherited
+    static Inherited takeover(const std::string& path);
+
+private:
+    enum Kind { kListen = 1, kConnection = 2, kDone = 3 };
+
+    struct Header
+    {
+        uint32_t kind;
+        uint32_t count;
+    };
+
+    // 单条消息最多携带的 fd 数 (内核上限 SCM_MAX_FD 为 253)
+    static const int kMaxFdsPerMessage = 128;
+    // 单次收发的超时
+    static const int kIoTimeoutSeconds = 5;
+
+    static bool sendFds(int unixFd, Kind kind, const std::vector<int>& fds);
+    static bool sendMessage(int unixFd, Kind kind, const int* fds, int count);
+};
+
+#endif
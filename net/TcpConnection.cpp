@@ -2,9 +2,11 @@
 
 #include "TcpConnection.h"
 #include "base/Logger.h"
+#include "base/Strand.h"
 #include "Socket.h"
 #include "Channel.h"
 #include "EventLoop.h"
+#include "CrossThreadSendQueue.h"
 
 #include <cerrno>
 #include <functional>
@@ -33,7 +35,10 @@ TcpConnection::TcpConnection(EventLoop* loop,
       m_localAddr(localAddr),
       m_peerAddr(peerAddr),
       // 流量控制,高水位线
-      m_highWaterMark(64 * 1024 * 1024) // 64M
+      m_highWaterMark(64 * 1024 * 1024), // 64M
+      m_autoCork(false),
+      m_corkDelayUs(0),
+      m_corkFlushPending(false)
 {
     // 下面给 channel 设置相应的回调函数，poller 给 channel 通知感兴趣的事件发生了，channel 会回调相应的操作函数
     m_channel->setReadCallback(
@@ -67,7 +72,23 @@ void TcpConnection::send(const std::string& buf)
         }
         else
         {
-            m_loop->runInLoop(std::bind(&TcpConnection::sendInLoop, this, buf.c_str(), buf.size()));
+            // 必须拷贝一份：调用者的 buf 在 IO 线程真正发送之前可能已经析构
+            CrossThreadSendQueue::forLoop(m_loop)->push(shared_from_this(), std::string(buf));
+        }
+    }
+}
+
+void TcpConnection::send(std::string&& buf)
+{
+    if (m_state == kConnected)
+    {
+        if (m_loop->isInLoopThread())
+        {
+            sendInLoop(buf.c_str(), buf.size());
+        }
+        else
+        {
+            CrossThreadSendQueue::forLoop(m_loop)->push(shared_from_this(), std::move(buf));
         }
     }
 }
@@ -88,13 +109,25 @@ void TcpConnection::sendInLoop(const void* data, size_t len)
         LOG_ERROR << "disconnected, give up writing!";
         return;
     }
+    m_lastActiveTime = m_loop->pollReturnMonoTime();
+
+    // 开启 auto-cork 且正处于事件处理阶段时，先不写，留到本轮结束时合并写
+    const bool corking = m_autoCork && m_loop->eventHandling();
 
     // 表示 channel_ 第一次开始写数据，而且缓冲区没有待发数据
-    if (!m_channel->isWriting() && m_outputBuffer.readableBytes() == 0)
+    if (!corking && !m_channel->isWriting() && m_outputBuffer.readableBytes() == 0)
     {
         nwrote = ::write(m_channel->fd(), data, len);
+        if (m_stats)
+        {
+            m_stats->addWriteCall();
+        }
         if (nwrote >= 0)
         {
+            if (m_stats)
+            {
+                m_stats->addBytesOut(nwrote);
+            }
             remaining = len - nwrote;
             if (remaining == 0 && m_writeCompleteCallback)
             {
@@ -106,6 +139,10 @@ void TcpConnection::sendInLoop(const void* data, size_t len)
         else // nwrote < 0
         {
             nwrote = 0;
+            if (errno == EWOULDBLOCK && m_stats)
+            {
+                m_stats->addEagain();
+            }
             if (errno != EWOULDBLOCK)
             {
                 LOG_ERROR << "TcpConnection::sendInLoop";
@@ -129,14 +166,58 @@ void TcpConnection::sendInLoop(const void* data, size_t len)
             m_loop->queueInLoop(
                 std::bind(m_highWaterMarkCallback, shared_from_this(), oldLen + remaining));
         }
+        if (m_stats)
+        {
+            if (oldLen == 0)
+            {
+                m_outputQueuedSince = MonoTime::now();
+            }
+            m_stats->updateOutputBufferPeak(oldLen + remaining);
+        }
         m_outputBuffer.append((char*)data + nwrote, remaining);
-        if (!m_channel->isWriting())
+        if (corking)
+        {
+            scheduleCorkFlush();
+        }
+        else if (!m_channel->isWriting())
         {
             m_channel->enableWriting(); // 这里一定要注册 channel 的写事件，否则 poller 不会给 channel 通知 epollout
         }
     }
 }
 
+void TcpConnection::scheduleCorkFlush()
+{
+    // 已经在等 EPOLLOUT 的话，handleWrite 会把新数据一起带走
+    if (m_corkFlushPending || m_channel->isWriting())
+    {
+        return;
+    }
+    m_corkFlushPending = true;
+    if (m_corkDelayUs > 0)
+    {
+        m_loop->runAfter(m_corkDelayUs / 1000000.0,
+            std::bind(&TcpConnection::flushCorked, shared_from_this()));
+    }
+    else
+    {
+        m_loop->queueAfterEvents(
+            std::bind(&TcpConnection::flushCorked, shared_from_this()));
+    }
+}
+
+void TcpConnection::flushCorked()
+{
+    m_loop->assertInLoopThread();
+    m_corkFlushPending = false;
+    if (m_state == kDisconnected || m_channel->isWriting() || m_outputBuffer.readableBytes() == 0)
+    {
+        return;
+    }
+    // 本轮攒下的数据在 outputBuffer 里是连续的，一次 write 就能全部交给内核
+    writeOutputBuffer();
+}
+
 void TcpConnection::shutdown()
 {
     if (m_state == kConnected)
@@ -150,17 +231,40 @@ void TcpConnection::shutdown()
 void TcpConnection::shutdownInLoop()
 {
     m_loop->assertInLoopThread();
-    if (!m_channel->isWriting()) // 说明 outputBuffer 中的数据已经全部发送完成
+    // 说明 outputBuffer 中的数据已经全部发送完成 (auto-cork 攒着的数据也算没发完)
+    if (!m_channel->isWriting() && m_outputBuffer.readableBytes() == 0)
     {
         m_socket->shutdownWrite(); // 关闭写端
     }
 }
 
+void TcpConnection::forceClose()
+{
+    if (m_state == kConnected || m_state == kDisconnecting)
+    {
+        setState(kDisconnecting);
+        // 必须持有 shared_ptr，防止回调执行前连接已被销毁
+        m_loop->queueInLoop(
+            std::bind(&TcpConnection::forceCloseInLoop, shared_from_this()));
+    }
+}
+
+void TcpConnection::forceCloseInLoop()
+{
+    m_loop->assertInLoopThread();
+    if (m_state == kConnected || m_state == kDisconnecting)
+    {
+        // 和对端关闭走同一条路径：通知用户，再由 TcpServer 移除连接
+        handleClose();
+    }
+}
+
 
 void TcpConnection::connectEstablished()
 {
     m_loop->assertInLoopThread();
     setState(kConnected);
+    m_lastActiveTime = MonoTime::now();
     m_channel->tie(shared_from_this());
     m_channel->enableReading(); // 向 poller 注册 channel 的 epollin 事件
 
@@ -180,14 +284,72 @@ void TcpConnection::connectDestroyed()
     m_channel->remove(); // 把 channel 从 poller 的 ChannelMap 中删除掉
 }
 
+Strand* TcpConnection::strand(ThreadPool* pool)
+{
+    m_loop->assertInLoopThread();
+    if (!m_strand)
+    {
+        m_strand = std::make_shared<Strand>(pool);
+    }
+    return m_strand.get();
+}
+
+void TcpConnection::enableStats()
+{
+    m_stats.reset(new TcpStats);
+}
+
+TcpStats::Snapshot TcpConnection::stats() const
+{
+    return m_stats ? m_stats->snapshot() : TcpStats::Snapshot();
+}
+
+
+int TcpConnection::detachForHandOff()
+{
+    m_loop->assertInLoopThread();
+    if (m_state != kConnected || m_channel->isWriting()
+        || m_inputBuffer.readableBytes() != 0 || m_outputBuffer.readableBytes() != 0)
+    {
+        return -1;
+    }
+    // 不再读取，之后到达的数据留在内核缓冲区里由新进程读取
+    setState(kDisconnecting);
+    m_channel->disableAll();
+    return m_channel->fd();
+}
+
+void TcpConnection::reattachAfterHandOff()
+{
+    m_loop->assertInLoopThread();
+    if (m_state == kDisconnecting)
+    {
+        // 停止读取期间到达的数据还在内核缓冲区里，重新关注读事件后照常读到
+        setState(kConnected);
+        m_channel->enableReading();
+    }
+}
 
 void TcpConnection::handleRead(Timestamp receiveTime)
 {
     m_loop->assertInLoopThread();
     int savedErrno = 0;
     ssize_t n = m_inputBuffer.readFd(m_channel->fd(), &savedErrno);
+    if (m_stats)
+    {
+        m_stats->addReadCall();
+        if (n > 0)
+        {
+            m_stats->addBytesIn(n);
+        }
+        else if (n < 0 && savedErrno == EAGAIN)
+        {
+            m_stats->addEagain();
+        }
+    }
     if (n > 0)
     {
+        m_lastActiveTime = m_loop->pollReturnMonoTime();
         // 已建立连接的用户，有可读事件发生了，调用用户传入的回调操作 onMessage
         m_messageCallback(shared_from_this(), &m_inputBuffer, receiveTime);
     }
@@ -208,34 +370,69 @@ void TcpConnection::handleWrite()
     m_loop->assertInLoopThread();
     if (m_channel->isWriting())
     {
-        int savedErrno = 0;
-        ssize_t n = m_outputBuffer.writeFd(m_channel->fd(), &savedErrno);
+        writeOutputBuffer();
+    }
+    else
+    {
+        LOG_ERROR << "TcpConnection fd=" << m_channel->fd()
+            << " is down, no more writing";
+    }
+}
+
+// 把 outputBuffer 写到 socket，handleWrite 和 auto-cork 的合并写共用
+void TcpConnection::writeOutputBuffer()
+{
+    int savedErrno = 0;
+    ssize_t n = m_outputBuffer.writeFd(m_channel->fd(), &savedErrno);
+    if (m_stats)
+    {
+        m_stats->addWriteCall();
         if (n > 0)
         {
-            m_outputBuffer.retrieve(n);
-            if (m_outputBuffer.readableBytes() == 0)
+            m_stats->addBytesOut(n);
+        }
+        else if (n < 0 && savedErrno == EAGAIN)
+        {
+            m_stats->addEagain();
+        }
+    }
+    if (n > 0)
+    {
+        m_lastActiveTime = m_loop->pollReturnMonoTime();
+        m_outputBuffer.retrieve(n);
+        if (m_outputBuffer.readableBytes() == 0)
+        {
+            if (m_stats)
+            {
+                int64_t delayUs = microSecondsBetween(MonoTime::now(), m_outputQueuedSince);
+                m_stats->addQueueDelay(delayUs > 0 ? static_cast<uint64_t>(delayUs) : 0);
+            }
+            if (m_channel->isWriting())
             {
                 m_channel->disableWriting();
-                if (m_writeCompleteCallback)
-                {
-                    m_loop->queueInLoop(
-                        std::bind(m_writeCompleteCallback, shared_from_this()));
-                }
-                if (m_state == kDisconnecting)
-                {
-                    shutdownInLoop();
-                }
+            }
+            if (m_writeCompleteCallback)
+            {
+                m_loop->queueInLoop(
+                    std::bind(m_writeCompleteCallback, shared_from_this()));
+            }
+            if (m_state == kDisconnecting)
+            {
+                shutdownInLoop();
             }
         }
-        else
+        else if (!m_channel->isWriting())
         {
-            LOG_ERROR << "TcpConnection::handleWrite";
+            m_channel->enableWriting(); // 没写完，剩下的交给 EPOLLOUT
         }
     }
+    else if (savedErrno == EAGAIN && !m_channel->isWriting())
+    {
+        m_channel->enableWriting();
+    }
     else
     {
-        LOG_ERROR << "TcpConnection fd=" << m_channel->fd()
-            << " is down, no more writing";
+        LOG_ERROR << "TcpConnection::handleWrite";
     }
 }
 
@@ -5,9 +5,11 @@
 
 #include "base/noncopyable.h"
 #include "base/Timestamp.h"
+#include "base/MonoTime.h"
 #include "InetAddress.h"
 #include "Callbacks.h" // 稍后我们会创建这个新文件
 #include "Buffer.h"
+#include "TcpStats.h"
 
 #include <memory>
 #include <string>
@@ -16,6 +18,8 @@
 class Channel;
 class EventLoop;
 class Socket;
+class Strand;
+class ThreadPool;
 
 /**
  * TcpConnection 是服务器与客户端之间连接的抽象。
@@ -41,10 +45,13 @@ public:
 
     bool connected() const { return m_state == kConnected; }
 
-    // 发送数据
+    // 发送数据；在其它线程调用时经 CrossThreadSendQueue 批量转交给 IO 线程
     void send(const std::string& buf);
+    void send(std::string&& buf);
     // 关闭连接
     void shutdown();
+    // 不等待 outputBuffer 发完，直接关闭连接 (例如空闲超时)
+    void forceClose();
 
     void setConnectionCallback(const ConnectionCallback& cb) { m_connectionCallback = cb; }
     void setMessageCallback(const MessageCallback& cb) { m_messageCallback = cb; }
@@ -53,11 +60,21 @@ public:
     { m_highWaterMarkCallback = cb; m_highWaterMark = highWaterMark; }
     void setCloseCallback(const CloseCallback& cb) { m_closeCallback = cb; }
 
+    // auto-cork：在一轮事件处理中多次 send 的数据先攒在 outputBuffer，
+    // 等本轮活跃 channel 处理完后一次写出 (maxDelayUs > 0 时改为最多延迟这么多微秒再写)
+    void setAutoCork(bool on, int maxDelayUs = 0) { m_autoCork = on; m_corkDelayUs = maxDelayUs; }
+
     // 当 TcpServer 接受一个新连接时调用
     void connectEstablished();
     // 当 TcpServer 移除一个连接时调用
     void connectDestroyed();
 
+    // 热重启：如果连接空闲 (收发缓冲区都为空)，停止读写并返回 fd 以便交给新进程，否则返回 -1
+    // 交出去之后本进程只能 close 自己的 fd，绝不能 shutdown (会影响新进程)
+    int detachForHandOff();
+    // 热重启：fd 没能交给新进程，撤销 detachForHandOff，连接继续由本进程读写
+    void reattachAfterHandOff();
+
     // 【新增】设置上下文 (例如 RpcContext)
     void setContext(const std::shared_ptr<void>& context)
     { m_context = context; }
@@ -66,7 +83,27 @@ public:
     std::shared_ptr<void> getContext() const
     { return m_context; }
 
+    // 【新增】本连接在 pool 上的串行执行器，第一次调用时创建 (之后传入的 pool 被忽略)，只能在 loop 线程调用。
+    // 同一连接的任务按顺序执行、不同连接并行，结果经 then 回到本连接的 loop，回复顺序与请求顺序一致：
+    //   conn->strand(&pool)->submit([req] { return handle(req); })
+    //       .then(conn->getLoop(), [conn](std::string reply) { conn->send(std::move(reply)); });
+    Strand* strand(ThreadPool* pool);
+
+    // 最近一次读写的时间，由 TimingWheel 用来判断连接是否空闲
+    MonoTime lastActiveTime() const { return m_lastActiveTime; }
+
+    // 开启流量统计，connectEstablished 之前调用；
+    // 连接关闭、移出 TcpServer 的连接表时，TcpServer 把它的统计并入所在 loop 的累计值
+    void enableStats();
+    bool statsEnabled() const { return m_stats != nullptr; }
+    // 任意线程可读，未开启时返回全 0
+    TcpStats::Snapshot stats() const;
+
 private:
+    // 跨线程 send 入队时已经检查过状态，取出后直接 sendInLoop，
+    // 不能再走 send：调用者紧接着 shutdown() 会把状态改成 kDisconnecting，回复会被丢掉
+    friend class CrossThreadSendQueue;
+
     enum StateE { kDisconnected, kConnecting, kConnected, kDisconnecting };
     void setState(StateE state) { m_state = state; }
 
@@ -76,7 +113,11 @@ private:
     void handleError();
 
     void sendInLoop(const void* data, size_t len);
+    void writeOutputBuffer();
+    void scheduleCorkFlush();
+    void flushCorked();
     void shutdownInLoop();
+    void forceCloseInLoop();
 
     EventLoop* m_loop; // 绝不是 subloop，TcpConnection 都是在 subloop 中管理的
     const std::string m_name;
@@ -98,11 +139,25 @@ private:
     CloseCallback m_closeCallback;
     size_t m_highWaterMark;
 
+    bool m_autoCork;
+    int m_corkDelayUs;
+    bool m_corkFlushPending; // 已经安排了一次合并写
+
     Buffer m_inputBuffer;  // 接收数据的缓冲区
     Buffer m_outputBuffer; // 发送数据的缓冲区
 
     // 【新增】通用上下文，由上层业务（如 RPC/HTTP）来定义具体内容
     std::shared_ptr<void> m_context;
+
+    // 卸载到线程池的处理按连接串行，见 strand()
+    std::shared_ptr<Strand> m_strand;
+
+    // 只在 loop 线程中读写，刷新时直接复用 poll 返回的时间，不额外读时钟
+    MonoTime m_lastActiveTime;
+
+    // 流量统计，未开启时为空，热路径上只多一次判空
+    std::unique_ptr<TcpStats> m_stats;
+    MonoTime m_outputQueuedSince; // outputBuffer 由空变非空的时刻
 };
 
 #endif
\ No newline at end of file
@@ -1,9 +1,47 @@
 #include "TcpServer.h"
 #include "base/Logger.h"
 #include "TcpConnection.h"
+#include "TimingWheel.h"
+#include "HotRestart.h"
+#include "Channel.h"
 
 #include <functional>
 #include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+// 旧连接在热重启后最多等待这么久，还没关闭的就强制关闭
+const double kDrainTimeoutSeconds = 30.0;
+const double kDrainTimeoutSlackSeconds = 1.0;
+
+InetAddress getLocalAddr(int sockfd)
+{
+    sockaddr_in addr;
+    ::memset(&addr, 0, sizeof(addr));
+    socklen_t addrlen = sizeof(addr);
+    if (::getsockname(sockfd, (sockaddr*)&addr, &addrlen) < 0)
+    {
+        LOG_ERROR << "sockets::getLocalAddr";
+    }
+    return InetAddress(addr);
+}
+
+InetAddress getPeerAddr(int sockfd)
+{
+    sockaddr_in addr;
+    ::memset(&addr, 0, sizeof(addr));
+    socklen_t addrlen = sizeof(addr);
+    if (::getpeername(sockfd, (sockaddr*)&addr, &addrlen) < 0)
+    {
+        LOG_ERROR << "sockets::getPeerAddr";
+    }
+    return InetAddress(addr);
+}
+
+} // namespace
 
 TcpServer::TcpServer(EventLoop* loop,
         const InetAddress& listenAddr,
@@ -17,7 +55,42 @@ TcpServer::TcpServer(EventLoop* loop,
       m_connectionCallback(),
       m_messageCallback(),
       m_started(0),
-      m_nextConnId(1)
+      m_nextConnId(1),
+      m_idleSeconds(0),
+      m_autoCork(false),
+      m_corkDelayUs(0),
+      m_statsEnabled(false),
+      m_handOffIdleConnections(false),
+      m_hotRestartFd(-1),
+      m_handOffFd(-1),
+      m_detachPending(0),
+      m_draining(false)
+{
+    m_acceptor->setNewConnectionCallback(std::bind(&TcpServer::newConnection, this,
+        std::placeholders::_1, std::placeholders::_2));
+}
+
+TcpServer::TcpServer(EventLoop* loop,
+        int inheritedListenFd,
+        const std::string& nameArg)
+    : m_loop(loop),
+      m_ipPort(getLocalAddr(inheritedListenFd).toIpPort()),
+      m_name(nameArg),
+      m_acceptor(new Acceptor(loop, inheritedListenFd)),
+      m_threadPool(new EventLoopThreadPool(loop, m_name)),
+      m_connectionCallback(),
+      m_messageCallback(),
+      m_started(0),
+      m_nextConnId(1),
+      m_idleSeconds(0),
+      m_autoCork(false),
+      m_corkDelayUs(0),
+      m_statsEnabled(false),
+      m_handOffIdleConnections(false),
+      m_hotRestartFd(-1),
+      m_handOffFd(-1),
+      m_detachPending(0),
+      m_draining(false)
 {
     m_acceptor->setNewConnectionCallback(std::bind(&TcpServer::newConnection, this,
         std::placeholders::_1, std::placeholders::_2));
@@ -25,6 +98,20 @@ TcpServer::TcpServer(EventLoop* loop,
 
 TcpServer::~TcpServer()
 {
+    if (m_hotRestartFd >= 0) // 还没有发生过交接
+    {
+        m_hotRestartChannel->disableAll();
+        m_hotRestartChannel->remove();
+        ::close(m_hotRestartFd);
+    }
+    if (m_handOffFd >= 0) // 交接进行到一半
+    {
+        ::close(m_handOffFd);
+    }
+    if (m_draining)
+    {
+        m_loop->cancel(m_drainTimer);
+    }
     for (auto& item : m_connections)
     {
         TcpConnectionPtr conn(item.second);
@@ -44,6 +131,22 @@ void TcpServer::start()
     if (m_started++ == 0) // 防止一个 TcpServer 对象被 start 多次
     {
         m_threadPool->start(m_threadInitCallback); // 启动底层的 loop 线程池
+        if (m_idleSeconds > 0)
+        {
+            for (EventLoop* ioLoop : m_threadPool->getAllLoops())
+            {
+                auto wheel = std::make_shared<TimingWheel>(ioLoop, m_idleSeconds);
+                m_idleWheels[ioLoop] = wheel;
+                ioLoop->runInLoop(std::bind(&TimingWheel::start, wheel));
+            }
+        }
+        if (m_statsEnabled)
+        {
+            for (EventLoop* ioLoop : m_threadPool->getAllLoops())
+            {
+                m_closedStats[ioLoop] = TcpStats::Snapshot();
+            }
+        }
         m_loop->runInLoop(std::bind(&Acceptor::listen, m_acceptor.get()));
     }
 }
@@ -94,9 +197,43 @@ void TcpServer::newConnection(int sockfd, const InetAddress& peerAddr)
     conn->setWriteCompleteCallback(m_writeCompleteCallback);
     conn->setCloseCallback(
         std::bind(&TcpServer::removeConnection, this, std::placeholders::_1));
+    conn->setAutoCork(m_autoCork, m_corkDelayUs);
+    if (m_statsEnabled)
+    {
+        conn->enableStats();
+    }
 
     // 步骤 8: 通知新员工去他被分配的“服务部门”报到并开始工作
     ioLoop->runInLoop(std::bind(&TcpConnection::connectEstablished, conn));
+
+    // 步骤 9: 开启了空闲超时的话，把新员工登记到该部门的时间轮上
+    auto wheelIt = m_idleWheels.find(ioLoop);
+    if (wheelIt != m_idleWheels.end())
+    {
+        ioLoop->runInLoop(std::bind(&TimingWheel::add, wheelIt->second, conn));
+    }
+}
+
+std::map<EventLoop*, TcpStats::Snapshot> TcpServer::loopStats() const
+{
+    m_loop->assertInLoopThread();
+    std::map<EventLoop*, TcpStats::Snapshot> result = m_closedStats;
+    for (const auto& item : m_connections)
+    {
+        const TcpConnectionPtr& conn = item.second;
+        result[conn->getLoop()].add(conn->stats());
+    }
+    return result;
+}
+
+TcpStats::Snapshot TcpServer::totalStats() const
+{
+    TcpStats::Snapshot total;
+    for (const auto& item : loopStats())
+    {
+        total.add(item.second);
+    }
+    return total;
 }
 
 void TcpServer::removeConnection(const TcpConnectionPtr& conn)
@@ -111,8 +248,219 @@ void TcpServer::removeConnectionInLoop(const TcpConnectionPtr& conn)
     LOG_INFO << "TcpServer::removeConnectionInLoop [" << m_name
         << "] - connection " << conn->name();
     
-    m_connections.erase(conn->name());
     EventLoop* ioLoop = conn->getLoop();
+    // 移出连接表的同一步把它的统计并入已关闭连接的累计，汇总值不会短暂变小。
+    // closeCallback 在 IO 线程停止读写之后才投递过来，此时计数已经不再变化
+    auto statsIt = m_closedStats.find(ioLoop);
+    if (m_connections.erase(conn->name()) > 0 && statsIt != m_closedStats.end())
+    {
+        statsIt->second.add(conn->stats());
+    }
     ioLoop->queueInLoop(
         std::bind(&TcpConnection::connectDestroyed, conn));
+
+    if (m_draining && m_connections.empty())
+    {
+        finishDraining();
+    }
+}
+
+void TcpServer::enableHotRestart(const std::string& unixPath, bool handOffIdleConnections)
+{
+    m_hotRestartPath = unixPath;
+    m_handOffIdleConnections = handOffIdleConnections;
+    m_loop->runInLoop(std::bind(&TcpServer::enableHotRestartInLoop, this));
+}
+
+void TcpServer::enableHotRestartInLoop()
+{
+    m_loop->assertInLoopThread();
+    m_hotRestartFd = HotRestart::listenUnix(m_hotRestartPath);
+    if (m_hotRestartFd < 0)
+    {
+        return;
+    }
+    m_hotRestartChannel.reset(new Channel(m_loop, m_hotRestartFd));
+    m_hotRestartChannel->setReadCallback(std::bind(&TcpServer::handleHotRestartRequest, this));
+    m_hotRestartChannel->enableReading();
+    LOG_INFO << "TcpServer [" << m_name << "] - hot restart enabled on " << m_hotRestartPath;
+}
+
+// 新进程连上了 unix socket：交出 fd，然后开始排空
+void TcpServer::handleHotRestartRequest()
+{
+    m_loop->assertInLoopThread();
+    // 只接受同一 uid 的进程，发送带超时 (见 HotRestart::acceptPeer)；被拒绝时继续等待下一个
+    int unixFd = HotRestart::acceptPeer(m_hotRestartFd);
+    if (unixFd < 0)
+    {
+        return;
+    }
+    LOG_INFO << "TcpServer [" << m_name << "] - new process is taking over";
+
+    // 一代进程只交接一次，之后由新进程在同一路径上重新监听
+    m_hotRestartChannel->disableAll();
+    m_hotRestartChannel->remove();
+    ::close(m_hotRestartFd);
+    m_hotRestartFd = -1;
+
+    // 1. 停止 accept，交出监听 fd
+    m_acceptor->stopListening();
+    if (!HotRestart::sendListenFds(unixFd, std::vector<int>(1, m_acceptor->fd())))
+    {
+        // 新进程没拿到监听 fd，本进程继续服务，并等待下一次接管
+        LOG_ERROR << "TcpServer [" << m_name << "] - hand off failed, keep serving";
+        ::close(unixFd);
+        m_acceptor->listen();
+        enableHotRestartInLoop();
+        return;
+    }
+
+    // 2. 交出空闲连接：各 IO 线程异步挑出来，到齐后由 finishHandOff 发送
+    m_handOffFd = unixFd;
+    if (m_handOffIdleConnections)
+    {
+        detachIdleConnections();
+    }
+    else
+    {
+        finishHandOff();
+    }
+}
+
+// 在各自的 IO 线程中挑出空闲连接并停止读写，结果送回 baseLoop 汇总。
+// baseLoop 不等待 IO 线程，期间照常处理其它事件
+void TcpServer::detachIdleConnections()
+{
+    std::map<EventLoop*, std::vector<TcpConnectionPtr>> connsByLoop;
+    for (const auto& item : m_connections)
+    {
+        connsByLoop[item.second->getLoop()].push_back(item.second);
+    }
+
+    m_detachPending = connsByLoop.size();
+    if (m_detachPending == 0)
+    {
+        finishHandOff();
+        return;
+    }
+    for (auto& item : connsByLoop)
+    {
+        item.first->runInLoop([this, conns = std::move(item.second)]() {
+            std::vector<HandOff> detached;
+            for (const TcpConnectionPtr& conn : conns)
+            {
+                int fd = conn->detachForHandOff();
+                if (fd >= 0)
+                {
+                    detached.push_back(HandOff{conn, fd});
+                }
+            }
+            m_loop->runInLoop([this, detached = std::move(detached)]() mutable {
+                collectDetached(std::move(detached));
+            });
+        });
+    }
+}
+
+void TcpServer::collectDetached(std::vector<HandOff> detached)
+{
+    m_loop->assertInLoopThread();
+    m_handedOff.insert(m_handedOff.end(), detached.begin(), detached.end());
+    if (--m_detachPending == 0)
+    {
+        finishHandOff();
+    }
+}
+
+void TcpServer::finishHandOff()
+{
+    std::vector<HandOff> handedOff;
+    handedOff.swap(m_handedOff);
+    std::vector<int> fds;
+    fds.reserve(handedOff.size());
+    for (const HandOff& item : handedOff)
+    {
+        fds.push_back(item.fd);
+    }
+    // 新进程只有收到 kDone 才接管这些连接 (见 HotRestart::takeover)
+    bool handedOver = HotRestart::sendConnFds(m_handOffFd, fds) && HotRestart::sendDone(m_handOffFd);
+    ::close(m_handOffFd);
+    m_handOffFd = -1;
+
+    if (handedOver)
+    {
+        LOG_INFO << "TcpServer [" << m_name << "] - handed off " << handedOff.size()
+                 << " idle connection(s), draining " << m_connections.size() - handedOff.size() << " more";
+        // 3. 交出去的连接在本进程中只需要关掉自己这份 fd
+        for (const HandOff& item : handedOff)
+        {
+            item.conn->forceClose();
+        }
+    }
+    else
+    {
+        // 新进程拿走监听 fd 之后出了问题：连接不能就这样关掉，恢复读写，和其它连接一起正常排空
+        LOG_ERROR << "TcpServer [" << m_name << "] - handing off " << handedOff.size()
+                  << " idle connection(s) failed, draining them here";
+        for (const HandOff& item : handedOff)
+        {
+            TcpConnectionPtr conn = item.conn;
+            conn->getLoop()->runInLoop([conn]() {
+                conn->reattachAfterHandOff();
+                conn->shutdown();
+            });
+        }
+    }
+    startDraining();
+}
+
+void TcpServer::startDraining()
+{
+    m_draining = true;
+    if (m_connections.empty())
+    {
+        finishDraining();
+        return;
+    }
+
+    for (const auto& item : m_connections)
+    {
+        // outputBuffer 发送完之后才会真正关闭写端
+        item.second->shutdown();
+    }
+
+    m_drainTimer = m_loop->runAfter(kDrainTimeoutSeconds, [this]() {
+        LOG_INFO << "TcpServer [" << m_name << "] - drain timeout, force closing "
+                 << m_connections.size() << " connection(s)";
+        for (const auto& item : m_connections)
+        {
+            item.second->forceClose();
+        }
+    }, kDrainTimeoutSlackSeconds);
+}
+
+void TcpServer::finishDraining()
+{
+    LOG_INFO << "TcpServer [" << m_name << "] - all connections drained";
+    m_draining = false;
+    m_loop->cancel(m_drainTimer);
+    if (m_drainedCallback)
+    {
+        m_drainedCallback();
+    }
+    else
+    {
+        m_loop->quit();
+    }
+}
+
+void TcpServer::adoptConnection(int sockfd)
+{
+    m_loop->runInLoop(std::bind(&TcpServer::adoptConnectionInLoop, this, sockfd));
+}
+
+void TcpServer::adoptConnectionInLoop(int sockfd)
+{
+    newConnection(sockfd, getPeerAddr(sockfd));
 }
\ No newline at end of file
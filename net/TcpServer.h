@@ -7,12 +7,16 @@
 #include "InetAddress.h"
 #include "EventLoopThreadPool.h"
 #include "Callbacks.h"
+#include "TcpStats.h"
 
 #include <functional>
 #include <string>
 #include <memory>
 #include <atomic>
 #include <map>
+#include <vector>
+
+class TimingWheel;
 
 class TcpServer : noncopyable
 {
@@ -26,6 +30,10 @@ public:
             const InetAddress& listenAddr,// 首要任务知道自己要建立监听的地址
             const std::string& nameArg,
             Option option = kNoReusePort);
+    // 热重启的新进程：直接使用从旧进程继承来的监听 fd (见 HotRestart::takeover)
+    TcpServer(EventLoop* loop,
+            int inheritedListenFd,
+            const std::string& nameArg);
     ~TcpServer();
 
     void setThreadInitcallback(const ThreadInitCallback& cb) { m_threadInitCallback = cb; }
@@ -34,14 +42,59 @@ public:
     void setWriteCompleteCallback(const WriteCompleteCallback& cb) { m_writeCompleteCallback = cb; }
 
     void setThreadNum(int numThreads);
+
+    // 连接空闲 (没有读写) 超过 seconds 秒就主动关闭，0 表示不启用
+    // 必须在 start() 之前调用，每个 IO loop 各自维护一个时间轮
+    void setIdleTimeout(int seconds) { m_idleSeconds = seconds; }
+
+    // 对之后建立的所有连接开启 auto-cork，见 TcpConnection::setAutoCork
+    void setAutoCork(bool on, int maxDelayUs = 0) { m_autoCork = on; m_corkDelayUs = maxDelayUs; }
+
+    // 开启连接级流量统计，必须在 start() 之前调用
+    void enableStats(bool on) { m_statsEnabled = on; }
+
+    // 以下两个接口会遍历连接表，必须在 baseLoop 线程中调用
+    // 每个 IO loop 的汇总 = 该 loop 上已关闭连接的累计 + 仍然存活的连接
+    std::map<EventLoop*, TcpStats::Snapshot> loopStats() const;
+    // 整个 server 的汇总
+    TcpStats::Snapshot totalStats() const;
+
     void start();
 
+    // --- 热重启 ---
+    // 旧进程：在 unixPath 上等待新进程来接管。新进程连上来后，交出监听 fd，
+    // handOffIdleConnections 为 true 时连同空闲连接一起交出；剩下的连接发完 outputBuffer 后关闭。
+    // 只接受与本进程 euid 相同的进程来接管；交接过程不阻塞 baseLoop 等待 IO 线程
+    void enableHotRestart(const std::string& unixPath, bool handOffIdleConnections = true);
+    // 旧进程的连接全部处理完时回调，默认退出 baseLoop
+    void setDrainedCallback(const std::function<void()>& cb) { m_drainedCallback = cb; }
+    // 新进程：接管一个继承来的已建立连接，在 start() 之后调用
+    void adoptConnection(int sockfd);
+
 private:
     void newConnection(int sockfd, const InetAddress& peerAddr);
     void removeConnection(const TcpConnectionPtr& conn);
     void removeConnectionInLoop(const TcpConnectionPtr& conn);
 
+    // 热重启时交给新进程的连接及其 fd
+    struct HandOff
+    {
+        TcpConnectionPtr conn;
+        int fd;
+    };
+
+    void enableHotRestartInLoop();
+    void handleHotRestartRequest();
+    void detachIdleConnections();
+    void collectDetached(std::vector<HandOff> detached);
+    void finishHandOff();
+    void startDraining();
+    void finishDraining();
+    void adoptConnectionInLoop(int sockfd);
+
     using ConnectionMap = std::map<std::string, TcpConnectionPtr>;
+    using TimingWheelMap = std::map<EventLoop*, std::shared_ptr<TimingWheel>>;
+    using LoopStatsMap = std::map<EventLoop*, TcpStats::Snapshot>;
 
     EventLoop* m_loop; // baseLoop 用户定义的 loop
     const std::string m_ipPort;
@@ -59,6 +112,27 @@ private:
     
     int m_nextConnId;
     ConnectionMap m_connections;
+
+    int m_idleSeconds;
+    TimingWheelMap m_idleWheels; // start() 之后只读
+
+    bool m_autoCork;
+    int m_corkDelayUs;
+
+    bool m_statsEnabled;
+    LoopStatsMap m_closedStats; // 各 IO loop 上已关闭连接的累计，只在 baseLoop 线程中读写
+
+    // 热重启 (只在 baseLoop 线程中访问)
+    std::string m_hotRestartPath;
+    bool m_handOffIdleConnections;
+    int m_hotRestartFd;
+    std::unique_ptr<Channel> m_hotRestartChannel;
+    int m_handOffFd;              // 与新进程之间的 unix 连接，交接完成前有效
+    size_t m_detachPending;       // 还没送回结果的 IO loop 数
+    std::vector<HandOff> m_handedOff;
+    bool m_draining;
+    TimerId m_drainTimer;
+    std::function<void()> m_drainedCallback;
 };
 
 #endif
\ No newline at end of file
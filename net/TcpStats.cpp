@@ -0,0 +1,52 @@
+// net/TcpStats.cpp
+
+#include "TcpStats.h"
+
+#include <algorithm>
+#include <cstdio>
+
+void TcpStats::Snapshot::add(const Snapshot& rhs)
+{
+    bytesIn += rhs.bytesIn;
+    bytesOut += rhs.bytesOut;
+    readCalls += rhs.readCalls;
+    writeCalls += rhs.writeCalls;
+    eagainCount += rhs.eagainCount;
+    outputBufferPeak = std::max(outputBufferPeak, rhs.outputBufferPeak);
+    queuedBursts += rhs.queuedBursts;
+    queueDelayUsTotal += rhs.queueDelayUsTotal;
+    queueDelayUsMax = std::max(queueDelayUsMax, rhs.queueDelayUsMax);
+}
+
+std::string TcpStats::Snapshot::toString() const
+{
+    char buf[256];
+    snprintf(buf, sizeof buf,
+             "in=%luB out=%luB reads=%lu writes=%lu eagain=%lu outPeak=%luB "
+             "queued=%lu queueDelayAvg=%luus queueDelayMax=%luus",
+             static_cast<unsigned long>(bytesIn),
+             static_cast<unsigned long>(bytesOut),
+             static_cast<unsigned long>(readCalls),
+             static_cast<unsigned long>(writeCalls),
+             static_cast<unsigned long>(eagainCount),
+             static_cast<unsigned long>(outputBufferPeak),
+             static_cast<unsigned long>(queuedBursts),
+             static_cast<unsigned long>(queuedBursts ? queueDelayUsTotal / queuedBursts : 0),
+             static_cast<unsigned long>(queueDelayUsMax));
+    return buf;
+}
+
+TcpStats::Snapshot TcpStats::snapshot() const
+{
+    Snapshot s;
+    s.bytesIn = m_bytesIn.load(std::memory_order_relaxed);
+    s.bytesOut = m_bytesOut.load(std::memory_order_relaxed);
+    s.readCalls = m_readCalls.load(std::memory_order_relaxed);
+    s.writeCalls = m_writeCalls.load(std::memory_order_relaxed);
+    s.eagainCount = m_eagainCount.load(std::memory_order_relaxed);
+    s.outputBufferPeak = m_outputBufferPeak.load(std::memory_order_relaxed);
+    s.queuedBursts = m_queuedBursts.load(std::memory_order_relaxed);
+    s.queueDelayUsTotal = m_queueDelayUsTotal.load(std::memory_order_relaxed);
+    s.queueDelayUsMax = m_queueDelayUsMax.load(std::memory_order_relaxed);
+    return s;
+}
@@ -0,0 +1,80 @@
+// net/TcpStats.h
+
+#ifndef TCPSTATS_H
+#define TCPSTATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 连接级的流量与延迟统计。
+ * 每个计数器只由连接所属的 loop 线程写入 (单写者)，所以增加时用 relaxed 的 load + store，
+ * 不需要带 lock 前缀的原子加；其它线程 (例如 baseLoop 汇总时) 可以随时读取快照。
+ * 用于定位哪些客户端导致 outputBuffer 膨胀和写放大。
+ */
+class TcpStats
+{
+public:
+    // 普通数值的快照，便于跨连接/跨 loop 求和
+    struct Snapshot
+    {
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+        uint64_t readCalls = 0;          // read/readv 系统调用次数
+        uint64_t writeCalls = 0;         // write 系统调用次数
+        uint64_t eagainCount = 0;        // 读写返回 EAGAIN 的次数
+        uint64_t outputBufferPeak = 0;   // outputBuffer 的最大积压字节数
+        uint64_t queuedBursts = 0;       // outputBuffer 由空变非空再被发完的次数
+        uint64_t queueDelayUsTotal = 0;  // 数据在 outputBuffer 中等待的总时长
+        uint64_t queueDelayUsMax = 0;    // 单次等待的最长时长
+
+        void add(const Snapshot& rhs);
+        std::string toString() const;
+    };
+
+    TcpStats() = default;
+    TcpStats(const TcpStats&) = delete;
+    TcpStats& operator=(const TcpStats&) = delete;
+
+    void addBytesIn(uint64_t n) { bump(m_bytesIn, n); }
+    void addBytesOut(uint64_t n) { bump(m_bytesOut, n); }
+    void addReadCall() { bump(m_readCalls, 1); }
+    void addWriteCall() { bump(m_writeCalls, 1); }
+    void addEagain() { bump(m_eagainCount, 1); }
+    void updateOutputBufferPeak(uint64_t bytes) { raise(m_outputBufferPeak, bytes); }
+    void addQueueDelay(uint64_t us)
+    {
+        bump(m_queuedBursts, 1);
+        bump(m_queueDelayUsTotal, us);
+        raise(m_queueDelayUsMax, us);
+    }
+
+    Snapshot snapshot() const;
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t n)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static void raise(std::atomic<uint64_t>& counter, uint64_t value)
+    {
+        if (value > counter.load(std::memory_order_relaxed))
+        {
+            counter.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint64_t> m_bytesIn{0};
+    std::atomic<uint64_t> m_bytesOut{0};
+    std::atomic<uint64_t> m_readCalls{0};
+    std::atomic<uint64_t> m_writeCalls{0};
+    std::atomic<uint64_t> m_eagainCount{0};
+    std::atomic<uint64_t> m_outputBufferPeak{0};
+    std::atomic<uint64_t> m_queuedBursts{0};
+    std::atomic<uint64_t> m_queueDelayUsTotal{0};
+    std::atomic<uint64_t> m_queueDelayUsMax{0};
+};
+
+#endif
@@ -4,7 +4,7 @@
 
 std::atomic<int64_t> Timer::s_numCreated;
 
-void Timer::restart(Timestamp now)
+void Timer::restart(MonoTime now)
 {
     if (m_repeat)
     {
@@ -12,9 +12,11 @@ void Timer::restart(Timestamp now)
         // 注意：这里简单地用 now + interval，而不是 m_expiration + interval
         // 是为了防止定时器处理由于系统繁忙滞后，导致后续的定时器“堆积”爆发
         m_expiration = addTime(now, m_interval);
+        m_deadline = addTime(m_expiration, m_slack);
     }
     else
     {
-        m_expiration = Timestamp(); // 设置为一个无效时间
+        m_expiration = MonoTime(); // 设置为一个无效时间
+        m_deadline = MonoTime();
     }
 }
\ No newline at end of file
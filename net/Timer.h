@@ -4,46 +4,82 @@
 #define TIMER_H
 
 #include "base/noncopyable.h"
-#include "base/Timestamp.h"
+#include "base/MonoTime.h"
 #include "Callbacks.h" // 包含 TimerCallback 定义 (需在 Callbacks.h 添加)
 
 #include <atomic>
 
+/**
+ * @brief 定时器对象。
+ * 由 TimerQueue 的对象池复用：到期或取消后不会 delete，而是 reinit 后再次使用，
+ * 每次 reinit 都会分配新的序号，旧的 TimerId 因序号不匹配而自动失效。
+ *
+ * 【新增】slack：允许在 [expiration, expiration + slack] 内的任意时刻触发。
+ * TimerQueue 按 deadline (= expiration + slack) 排序，借此把窗口重叠的定时器合并成一批。
+ */
 class Timer : noncopyable
 {
 public:
-    using TimerCallback = std::function<void()>;
+    Timer(TimerCallback cb, MonoTime when, double interval, double slack = 0.0)
+        : m_heapIndex(-1),
+          m_canceled(false)
+    {
+        reinit(std::move(cb), when, interval, slack);
+    }
 
-    Timer(TimerCallback cb, Timestamp when, double interval)
-        : m_callback(std::move(cb)),
-          m_expiration(when),
-          m_interval(interval),
-          m_repeat(interval > 0.0),
-          m_sequence(s_numCreated++) // 每一个 Timer 都有唯一的序列号
-    {}
+    // 【新增】从对象池取出时重新初始化
+    void reinit(TimerCallback cb, MonoTime when, double interval, double slack = 0.0)
+    {
+        m_callback = std::move(cb);
+        m_expiration = when;
+        m_slack = slack > 0.0 ? slack : 0.0;
+        m_deadline = addTime(when, m_slack);
+        m_interval = interval;
+        m_repeat = interval > 0.0;
+        m_sequence = s_numCreated++; // 每一次使用都有唯一的序列号
+        m_canceled = false;
+    }
+
+    // 【新增】归还对象池前释放回调捕获的资源 (例如 shared_ptr)
+    void release() { m_callback = nullptr; }
 
     void run() const
     {
         if (m_callback) m_callback();
     }
 
-    Timestamp expiration() const { return m_expiration; }
+    MonoTime expiration() const { return m_expiration; }
+    // 【新增】最晚触发时间
+    MonoTime deadline() const { return m_deadline; }
+    double slack() const { return m_slack; }
     bool repeat() const { return m_repeat; }
     int64_t sequence() const { return m_sequence; }
 
+    // 【新增】在 TimerQueue 堆数组中的下标，-1 表示不在堆中 (已到期、已取消或在池中)
+    int heapIndex() const { return m_heapIndex; }
+    void setHeapIndex(int index) { m_heapIndex = index; }
+
+    // 【新增】在自己或同批其它定时器的回调中被取消
+    bool canceled() const { return m_canceled; }
+    void setCanceled() { m_canceled = true; }
+
     // 如果是重复定时器，重启它（更新下一次过期时间）
-    void restart(Timestamp now);
+    void restart(MonoTime now);
 
     static int64_t numCreated() { return s_numCreated; }
 
 private:
-    const TimerCallback m_callback; // 定时器回调
-    Timestamp m_expiration;         // 下一次的过期时间
-    const double m_interval;        // 重复间隔 (0.0 表示一次性)
-    const bool m_repeat;            // 是否重复
-    const int64_t m_sequence;       // 全局唯一序号
+    TimerCallback m_callback;   // 定时器回调
+    MonoTime m_expiration;      // 下一次的过期时间 (最早触发时间)
+    MonoTime m_deadline;        // m_expiration + m_slack
+    double m_slack;             // 允许推迟的秒数
+    double m_interval;          // 重复间隔 (0.0 表示一次性)
+    bool m_repeat;              // 是否重复
+    int64_t m_sequence;         // 全局唯一序号
+    int m_heapIndex;
+    bool m_canceled;
 
     static std::atomic<int64_t> s_numCreated;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -28,24 +28,18 @@ int createTimerfd()
     return timerfd;
 }
 
-// 计算还有多久过期，并转换成内核需要的 timespec 结构
-struct timespec howMuchTimeFromNow(Timestamp when)
+// 【修改】MonoTime 与 timerfd 同在 CLOCK_MONOTONIC 时间轴上，直接设置绝对时间，
+// 不再用"到期时间 - 当前墙上时间"换算，系统时间跳变不会影响定时器
+struct timespec toTimespec(MonoTime when)
 {
-    int64_t microseconds = when.microSecondsSinceEpoch()
-                         - Timestamp::now().microSecondsSinceEpoch();
-    if (microseconds < 100)
-    {
-        microseconds = 100; // 至少等待 100 微秒
-    }
-    
     struct timespec ts;
-    ts.tv_sec = static_cast<time_t>(microseconds / Timestamp::kMicroSecondsPerSecond);
-    ts.tv_nsec = static_cast<long>((microseconds % Timestamp::kMicroSecondsPerSecond) * 1000);
+    ts.tv_sec = static_cast<time_t>(when.nanoSeconds() / MonoTime::kNanoSecondsPerSecond);
+    ts.tv_nsec = static_cast<long>(when.nanoSeconds() % MonoTime::kNanoSecondsPerSecond);
     return ts;
 }
 
 // 处理 timerfd 的读事件 (清除就绪状态)
-void readTimerfd(int timerfd, Timestamp now)
+void readTimerfd(int timerfd)
 {
     uint64_t howmany;
     ssize_t n = ::read(timerfd, &howmany, sizeof howmany);
@@ -56,7 +50,7 @@ void readTimerfd(int timerfd, Timestamp now)
 }
 
 // 重置 timerfd 的过期时间
-void resetTimerfd(int timerfd, Timestamp expiration)
+void resetTimerfd(int timerfd, MonoTime expiration)
 {
     // 唤醒 EventLoop 的时间点
     struct itimerspec newValue;
@@ -64,10 +58,10 @@ void resetTimerfd(int timerfd, Timestamp expiration)
     memset(&newValue, 0, sizeof newValue);
     memset(&oldValue, 0, sizeof oldValue);
 
-    // 核心：计算相对时间，设置超时
-    newValue.it_value = howMuchTimeFromNow(expiration);
+    // 核心：设置绝对到期时间，已经过去的时间点会立即触发
+    newValue.it_value = toTimespec(expiration);
     
-    int ret = ::timerfd_settime(timerfd, 0, &newValue, &oldValue);
+    int ret = ::timerfd_settime(timerfd, TFD_TIMER_ABSTIME, &newValue, &oldValue);
     if (ret)
     {
         LOG_ERROR << "timerfd_settime()";
@@ -80,7 +74,7 @@ TimerQueue::TimerQueue(EventLoop* loop)
     : m_loop(loop),
       m_timerfd(createTimerfd()),
       m_timerfdChannel(loop, m_timerfd),
-      m_timers(),
+      m_timerfdExpiration(),
       m_callingExpiredTimers(false)
 {
     // 设置回调：当 timerfd 有事件（超时）时，执行 handleRead
@@ -95,168 +89,321 @@ TimerQueue::~TimerQueue()
     m_timerfdChannel.disableAll();
     m_timerfdChannel.remove();
     ::close(m_timerfd);
-    // 清理所有 Timer
-    for (const auto& timer : m_timers)
-    {
-        delete timer.second;
-    }
+    // 所有 Timer 都归 m_storage 所有，随之释放
 }
 
-TimerId TimerQueue::addTimer(std::function<void()> cb, Timestamp when, double interval)
+TimerId TimerQueue::addTimer(TimerCallback cb, MonoTime when, double interval, double slack)
 {
-    Timer* timer = new Timer(std::move(cb), when, interval);
+    if (m_loop->isInLoopThread())
+    {
+        Timer* timer = acquireTimer(std::move(cb), when, interval, slack);
+        insert(timer);
+        return TimerId(timer, timer->sequence());
+    }
+
+    // 对象池只在 IO 线程中访问，其它线程单独分配一次，插入时交给对象池
+    Timer* timer = new Timer(std::move(cb), when, interval, slack);
+    // 交出去之后 IO 线程可能已经触发、回收并复用了它，序号必须在交出之前读
+    int64_t sequence = timer->sequence();
     m_loop->runInLoop(
-        std::bind(&TimerQueue::insert, this, timer));
-        
-    return TimerId(timer, timer->sequence());
+        std::bind(&TimerQueue::adoptAndInsert, this, timer));
+    return TimerId(timer, sequence);
 }
 
 void TimerQueue::cancel(TimerId timerId)
 {
+    // IO 线程中直接取消，省掉一次 Functor 的构造
+    if (m_loop->isInLoopThread())
+    {
+        cancelInLoop(timerId);
+        return;
+    }
     // 必须保证线程安全，将操作派发到 IO 线程
     m_loop->runInLoop(
         std::bind(&TimerQueue::cancelInLoop, this, timerId));
 }
 
-// 【新增】需要在 TimerQueue.h 的 private 中声明 void cancelInLoop(TimerId timerId);
 void TimerQueue::cancelInLoop(TimerId timerId)
 {
     m_loop->assertInLoopThread();
-    assert(m_timers.size() == m_activeTimers.size());
 
-    // 构造一个 ActiveTimer 对象用于查找
-    ActiveTimer timer(timerId.m_timer, timerId.m_sequence);
+    Timer* timer = timerId.m_timer;
+    // Timer 不会在 TimerQueue 析构前释放，序号不同说明它已经到期/取消并被复用
+    if (timer == nullptr || timer->sequence() != timerId.m_sequence)
+    {
+        return;
+    }
 
-    // 查找该定时器是否存在于活跃列表中
-    auto it = m_activeTimers.find(timer);
-    if (it != m_activeTimers.end())
+    if (timer->heapIndex() >= 0)
     {
-        // 情况1：定时器还在队列中，直接删除
-        size_t n = m_timers.erase(Entry(it->first->expiration(), it->first));
-        assert(n == 1); (void)n;
-        delete it->first; // FIXME: no delete please (如果是用 unique_ptr 管理则不需要)
-        m_activeTimers.erase(it);
+        // 情况1：定时器还在堆中，凭下标直接删除
+        heapRemove(timer);
+        releaseTimer(timer);
+        // 被删的可能是堆顶的 slack 定时器，新的堆顶若是精确定时器需要设置 timerfd
+        // (新堆顶不早于已设置的时间点时不会有系统调用)
+        updateTimerfd();
     }
     else if (m_callingExpiredTimers)
     {
-        // 情况2：定时器正在执行回调（自我取消），此时它不在 m_activeTimers 中
-        // 我们把它加入“待取消列表”，防止 reset 时被重启
-        m_cancelingTimers.insert(timer);
+        // 情况2：定时器在本轮到期列表中（自我取消，或被同一批里更早的回调取消）
+        // 打上标记：还没运行的不再运行，重复定时器不再重启
+        timer->setCanceled();
     }
-    assert(m_timers.size() == m_activeTimers.size());
 }
 
-// 核心逻辑：向 set 中插入定时器
-bool TimerQueue::insert(Timer* timer)
+void TimerQueue::adoptAndInsert(Timer* timer)
 {
-    m_loop->assertInLoopThread(); // 必须在 IO 线程
-    
-    bool earliestChanged = false;
-    Timestamp when = timer->expiration();
-    auto it = m_timers.begin();
-    
-    // 如果 timers 为空，或者新定时器的过期时间比当前最早的还要早
-    if (it == m_timers.end() || when < it->first)
+    m_loop->assertInLoopThread();
+    m_storage.emplace_back(timer);
+    insert(timer);
+}
+
+Timer* TimerQueue::acquireTimer(TimerCallback cb, MonoTime when, double interval, double slack)
+{
+    if (m_freeTimers.empty())
     {
-        earliestChanged = true;
+        Timer* timer = new Timer(std::move(cb), when, interval, slack);
+        m_storage.emplace_back(timer);
+        return timer;
     }
-    
-    // 插入到 set 中
-    m_timers.insert(Entry(when, timer));
-    m_activeTimers.insert(ActiveTimer(timer, timer->sequence()));
+    Timer* timer = m_freeTimers.back();
+    m_freeTimers.pop_back();
+    timer->reinit(std::move(cb), when, interval, slack);
+    return timer;
+}
+
+void TimerQueue::releaseTimer(Timer* timer)
+{
+    timer->release();
+    m_freeTimers.push_back(timer);
+}
 
-    // 如果最早过期时间变了，需要重置 timerfd
+// 核心逻辑：向堆中插入定时器
+bool TimerQueue::insert(Timer* timer)
+{
+    m_loop->assertInLoopThread(); // 必须在 IO 线程
+
+    heapPush(timer);
+
+    // 新定时器到了堆顶，说明最早过期时间变了
+    // 精确定时器需要重置 timerfd；slack 定时器下一轮 poll 时自然会用上新的超时
+    bool earliestChanged = (timer->heapIndex() == 0);
     if (earliestChanged)
     {
-        resetTimerfd(m_timerfd, when);
+        updateTimerfd();
     }
     return earliestChanged;
 }
 
+bool TimerQueue::precise(const Timer* timer)
+{
+    return microSecondsBetween(timer->deadline(), timer->expiration()) < kPollResolutionUs;
+}
+
+void TimerQueue::updateTimerfd()
+{
+    if (m_heap.empty() || !precise(m_heap.front()))
+    {
+        // 不主动撤销已设置的 timerfd：提前醒来一次无害，省下一次 timerfd_settime
+        return;
+    }
+    // 只在需要更早醒来时重设。堆顶被取消后 timerfd 仍指向更早的时间点，
+    // 到时空醒一次，handleRead 再按新的堆顶设置；这样 deadline 型的"添加-取消"不必每次都调用 timerfd_settime
+    MonoTime expiration = m_heap.front()->expiration();
+    if (!m_timerfdExpiration.valid() || expiration < m_timerfdExpiration)
+    {
+        resetTimerfd(m_timerfd, expiration);
+        m_timerfdExpiration = expiration;
+    }
+}
+
+int TimerQueue::pollTimeout(int maxTimeoutMs) const
+{
+    if (m_heap.empty() || precise(m_heap.front()))
+    {
+        return maxTimeoutMs;
+    }
+    // 在 deadline 醒来，尽量把更多定时器攒成一批；向下取整到毫秒，保证不晚于 deadline
+    int64_t microseconds = microSecondsBetween(m_heap.front()->deadline(), MonoTime::now());
+    if (microseconds <= 0)
+    {
+        return 0;
+    }
+    int64_t timeoutMs = microseconds / kPollResolutionUs;
+    return timeoutMs < maxTimeoutMs ? static_cast<int>(timeoutMs) : maxTimeoutMs;
+}
+
 // timerfd 可读（超时）时的回调
 void TimerQueue::handleRead()
 {
     m_loop->assertInLoopThread();
-    Timestamp now(Timestamp::now());
-    
     // 1. 清除该事件，避免一直触发
-    readTimerfd(m_timerfd, now);
+    readTimerfd(m_timerfd);
+    m_timerfdExpiration = MonoTime();
+
+    processExpired(MonoTime::now());
+    // 可能是空醒 (原来的堆顶已被取消)，没有定时器到期时 reset 不会执行，这里补设 timerfd
+    updateTimerfd();
+}
+
+void TimerQueue::processExpired(MonoTime now)
+{
+    m_loop->assertInLoopThread();
+    if (m_heap.empty() || now < m_heap.front()->expiration())
+    {
+        // 堆顶的窗口还没打开 (poll 被其它事件唤醒)，什么也不用做
+        return;
+    }
 
     // 2. 获取所有已超时的定时器
-    std::vector<Timer*> expired = getExpired(now);
+    getExpired(now);
 
     m_callingExpiredTimers = true;
-    m_cancelingTimers.clear();
 
-    // 3. 执行回调
-    for (const auto& timer : expired)
+    // 3. 执行回调 (回调中可能新增定时器，但不会改动 m_expired)
+    for (Timer* timer : m_expired)
     {
-        timer->run();
+        if (!timer->canceled())
+        {
+            timer->run();
+        }
     }
     m_callingExpiredTimers = false;
 
-    // 4. 重置（如果是重复定时器，重新加入集合；否则销毁）
-    reset(expired, now);
+    // 4. 重置（如果是重复定时器，重新加入堆；否则归还对象池）
+    reset(now);
 }
 
-std::vector<Timer*> TimerQueue::getExpired(Timestamp now)
+void TimerQueue::getExpired(MonoTime now)
 {
-    std::vector<Timer*> expired;
-    
-    // 创建一个哨兵值 (now, UINTPTR_MAX)
-    // 它的意思是：同一时刻的 Timer，地址最大的那个（也就是这一时刻的所有 Timer）
-    Entry sentry(now, reinterpret_cast<Timer*>(UINTPTR_MAX));
-    
-    // lower_bound 返回第一个 >= sentry 的迭代器
-    // 所以 [begin, end) 就是所有 <= now 的定时器，即已过期的
-    auto end = m_timers.lower_bound(sentry);
-    
-    // 【修改】使用 std::copy 无法直接转换类型，改用手动循环或 std::transform
-    // 为了代码简洁易懂，我们直接用 range-based for loop 之前的迭代器循环
-    for (auto it = m_timers.begin(); it != end; ++it)
+    m_expired.clear();
+    // 堆按 deadline 排序：从堆顶依次取出窗口已经打开 (expiration <= now) 的定时器，
+    // 遇到第一个还没到最早触发时间的就停下 (与 Linux hrtimer 的 soft/hard expiry 处理方式相同)
+    while (!m_heap.empty() && !(now < m_heap.front()->expiration()))
+    {
+        Timer* timer = m_heap.front();
+        heapRemove(timer);
+        m_expired.push_back(timer);
+    }
+}
+
+void TimerQueue::reset(MonoTime now)
+{
+    for (Timer* timer : m_expired)
     {
-        expired.push_back(it->second);
+        // 如果是重复定时器，且没有在回调中被取消，才重启
+        if (timer->repeat() && !timer->canceled())
+        {
+            timer->restart(now);
+            heapPush(timer);
+        }
+        else
+        {
+            // 否则（是一次性定时器，或者已经被取消了），归还对象池
+            releaseTimer(timer);
+        }
     }
+    m_expired.clear();
 
-    // 删除过期的定时器
-    m_timers.erase(m_timers.begin(), end);
+    // 重启的定时器统一在这里设置一次 timerfd，而不是每插入一个设置一次
+    updateTimerfd();
+}
+
+// ---------------- 4 叉最小堆 ----------------
+// 节点 i 的子节点为 4i+1 ... 4i+4，父节点为 (i-1)/4。
+// 相比二叉堆层数减半，sift 时比较的 4 个子节点位于相邻内存，缓存更友好。
 
-    // 同时从 activeTimers 中移除
-    for (const auto& it : expired)
+bool TimerQueue::earlier(const Timer* lhs, const Timer* rhs)
+{
+    // 按 deadline 排序 (精确定时器的 deadline 就是到期时间)
+    // 相同时按序号排序，保证同一时刻的定时器按添加顺序触发
+    if (lhs->deadline() == rhs->deadline())
     {
-        ActiveTimer timer(it, it->sequence());
-        m_activeTimers.erase(timer);
+        return lhs->sequence() < rhs->sequence();
     }
+    return lhs->deadline() < rhs->deadline();
+}
 
-    return expired;
+void TimerQueue::placeAt(size_t index, Timer* timer)
+{
+    m_heap[index] = timer;
+    timer->setHeapIndex(static_cast<int>(index));
 }
 
-void TimerQueue::reset(const std::vector<Timer*>& expired, Timestamp now)
+void TimerQueue::heapPush(Timer* timer)
 {
-    Timestamp nextExpire;
+    m_heap.push_back(timer);
+    timer->setHeapIndex(static_cast<int>(m_heap.size() - 1));
+    siftUp(m_heap.size() - 1);
+}
 
-    for (const auto& timer : expired)
+void TimerQueue::heapRemove(Timer* timer)
+{
+    size_t index = static_cast<size_t>(timer->heapIndex());
+    assert(index < m_heap.size() && m_heap[index] == timer);
+
+    Timer* last = m_heap.back();
+    m_heap.pop_back();
+    timer->setHeapIndex(-1);
+    if (last == timer)
     {
-        ActiveTimer activeTimer(timer, timer->sequence());
-        
-        // 【修改逻辑】
-        //如果是重复定时器，且【不在】取消列表中，才重启
-        if (timer->repeat() && 
-            m_cancelingTimers.find(activeTimer) == m_cancelingTimers.end())
-        {
-            timer->restart(now);
-            insert(timer);
-        }
-        else
+        return;
+    }
+
+    // 用最后一个元素填补空位，再向上或向下调整
+    placeAt(index, last);
+    if (index > 0 && earlier(last, m_heap[(index - 1) / kHeapArity]))
+    {
+        siftUp(index);
+    }
+    else
+    {
+        siftDown(index);
+    }
+}
+
+void TimerQueue::siftUp(size_t index)
+{
+    Timer* timer = m_heap[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / kHeapArity;
+        if (!earlier(timer, m_heap[parent]))
         {
-            // 否则（是一次性定时器，或者已经被取消了），直接删除
-            delete timer; 
+            break;
         }
+        placeAt(index, m_heap[parent]);
+        index = parent;
     }
+    placeAt(index, timer);
+}
 
-    if (!m_timers.empty())
+void TimerQueue::siftDown(size_t index)
+{
+    const size_t size = m_heap.size();
+    Timer* timer = m_heap[index];
+    while (true)
     {
-        nextExpire = m_timers.begin()->second->expiration();
-        resetTimerfd(m_timerfd, nextExpire);
+        size_t first = index * kHeapArity + 1;
+        if (first >= size)
+        {
+            break;
+        }
+        size_t last = std::min(first + kHeapArity, size);
+        size_t smallest = first;
+        for (size_t child = first + 1; child < last; ++child)
+        {
+            if (earlier(m_heap[child], m_heap[smallest]))
+            {
+                smallest = child;
+            }
+        }
+        if (!earlier(m_heap[smallest], timer))
+        {
+            break;
+        }
+        placeAt(index, m_heap[smallest]);
+        index = smallest;
     }
-}
\ No newline at end of file
+    placeAt(index, timer);
+}
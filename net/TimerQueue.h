@@ -3,13 +3,14 @@
 #ifndef TIMERQUEUE_H
 #define TIMERQUEUE_H
 
-#include <set>
+#include <functional>
 #include <vector>
 #include <memory>
 
-#include "base/Timestamp.h"
+#include "base/MonoTime.h"
 #include "base/noncopyable.h"
 #include "Channel.h"
+#include "Callbacks.h"
 
 class EventLoop;
 class Timer;
@@ -19,6 +20,19 @@ class TimerId;
  * @brief 定时器队列，基于 timerfd 实现。
  * 这是一个内部类，不应该暴露给用户。
  * 它持有 Timer 列表，并负责管理 timerfd，当最早的定时器到期时触发 handleRead。
+ *
+ * 【修改】定时器保存在带下标的 4 叉最小堆中 (按到期时间、序号排序)：
+ * - 每个 Timer 记录自己在堆数组中的下标，cancel 时 O(1) 定位，O(log n) 删除，无需查找；
+ * - 堆是一个连续的 vector，增删不分配节点；
+ * - Timer 对象来自本 loop 的对象池，到期/取消后归还，直到 TimerQueue 析构才释放。
+ *   因此 TimerId 中的指针始终可以安全解引用，靠序号判断是否已失效。
+ *
+ * 【新增】slack 定时器：
+ * - 堆按 deadline (到期时间 + slack) 排序；堆顶到了 deadline 时，
+ *   把所有"窗口已经打开" (expiration <= now) 的定时器一起触发，重叠的窗口合并为一批；
+ * - slack 不小于 poll 的精度 (1ms) 时，堆顶直接决定 Poller::poll 的超时时间，
+ *   不调用 timerfd_settime，也不需要 read timerfd，每个周期省下两次系统调用；
+ * - 只有 slack 小于 1ms 的精确定时器在堆顶时才设置 timerfd。
  */
 class TimerQueue : noncopyable
 {
@@ -26,48 +40,70 @@ public:
     explicit TimerQueue(EventLoop* loop);
     ~TimerQueue();
 
-    // 插入定时器 (由 EventLoop 线程调用)
-    // 必须是线程安全的，通常由 EventLoop::runInLoop 调用
-    TimerId addTimer(std::function<void()> cb, Timestamp when, double interval);
+    // 插入定时器 (线程安全)
+    // 在 IO 线程中直接从对象池分配并插入；其它线程 new 一个 Timer，插入时由对象池接管
+    // slack 为允许推迟的秒数，0 表示精确定时器
+    TimerId addTimer(TimerCallback cb, MonoTime when, double interval, double slack = 0.0);
 
     // 取消定时器
     void cancel(TimerId timerId);
 
+    // 【新增】以下两个函数由 EventLoop::loop 在 IO 线程中调用
+    // 根据堆顶的 slack 定时器计算 poll 的超时时间，不超过 maxTimeoutMs
+    int pollTimeout(int maxTimeoutMs) const;
+    // poll 返回后触发所有窗口已打开的定时器
+    void processExpired(MonoTime now);
+
 private:
     // timerfd 变为可读时的回调
     void handleRead();
     
-    // 核心逻辑：获取所有已过期的定时器
-    std::vector<Timer*> getExpired(Timestamp now);
+    // 堆顶变化后，按需设置 timerfd
+    void updateTimerfd();
+
+    // 核心逻辑：把所有已过期的定时器从堆中取出，放入 m_expired
+    void getExpired(MonoTime now);
     
-    // 核心逻辑：重置这些定时器（如果是重复的则再次添加，否则销毁）
-    void reset(const std::vector<Timer*>& expired, Timestamp now);
+    // 核心逻辑：重置这些定时器（如果是重复的则再次添加，否则归还对象池）
+    void reset(MonoTime now);
 
     void cancelInLoop(TimerId timerId);
     
-    // 插入定时器的内部实现
+    // 插入定时器的内部实现，返回最早到期时间是否改变
     bool insert(Timer* timer);
+    // 其它线程创建的 Timer：交给对象池管理后插入
+    void adoptAndInsert(Timer* timer);
+
+    // 对象池 (仅 IO 线程)
+    Timer* acquireTimer(TimerCallback cb, MonoTime when, double interval, double slack);
+    void releaseTimer(Timer* timer);
+
+    // 4 叉堆操作
+    static bool earlier(const Timer* lhs, const Timer* rhs);
+    void heapPush(Timer* timer);
+    void heapRemove(Timer* timer);
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+    void placeAt(size_t index, Timer* timer);
+
+    static const size_t kHeapArity = 4;
+    // slack 不小于这个值的定时器由 poll 超时驱动 (epoll_wait 的超时精度为毫秒)
+    static const int64_t kPollResolutionUs = 1000;
+
+    static bool precise(const Timer* timer);
 
     EventLoop* m_loop;
     const int m_timerfd;        // Linux 特有的定时器文件描述符
     Channel m_timerfdChannel;   // 用于监听 timerfd 的 Channel
-    
-    // Timer list sorted by expiration
-    // 使用 pair<Timestamp, Timer*> 是为了处理两个定时器到期时间完全相同的情况
-    // 此时通过 Timer* 的地址大小来区分，保证 set 中元素的唯一性
-    using Entry = std::pair<Timestamp, Timer*>;
-    using TimerList = std::set<Entry>;
-    
-    // 同样用于保存 Timer，用于 cancel 时的查找
-    using ActiveTimer = std::pair<Timer*, int64_t>;
-    using ActiveTimerSet = std::set<ActiveTimer>;
 
-    TimerList m_timers;          // 按时间排序的主列表
-    ActiveTimerSet m_activeTimers; // 按对象地址排序的辅助列表（用于删除）
-    
+    MonoTime m_timerfdExpiration;                  // timerfd 当前设置的到期时间，无效表示未设置
+    std::vector<Timer*> m_heap;                    // 按 deadline 排列的 4 叉最小堆
+    std::vector<Timer*> m_expired;                 // 本轮到期的定时器，复用以避免每次分配
+    std::vector<std::unique_ptr<Timer>> m_storage; // 对象池拥有的全部 Timer
+    std::vector<Timer*> m_freeTimers;              // 空闲的 Timer
+
     // 标识是否正在处理过期定时器（用于处理在回调中把自己 cancel 掉的边缘情况）
     bool m_callingExpiredTimers; 
-    ActiveTimerSet m_cancelingTimers; // 保存正在取消的定时器
 };
 
-#endif
\ No newline at end of file
+#endif
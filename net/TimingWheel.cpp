@@ -0,0 +1,85 @@
+// net/TimingWheel.cpp
+
+#include "TimingWheel.h"
+#include "TcpConnection.h"
+#include "EventLoop.h"
+#include "base/Logger.h"
+
+namespace
+{
+const double kTickSlackSeconds = 0.1;
+}
+
+TimingWheel::TimingWheel(EventLoop* loop, int idleSeconds)
+    : m_loop(loop),
+      m_idleSeconds(idleSeconds),
+      m_buckets(idleSeconds + 1),
+      m_cursor(0)
+{}
+
+TimingWheel::~TimingWheel() {}
+
+void TimingWheel::start()
+{
+    m_loop->assertInLoopThread();
+    // 定时器只持有 weak_ptr，TcpServer 析构后 tick 自动变成空操作
+    // 精度只到秒，给 100ms 的 slack，与同一 loop 上的其它 slack 定时器合并触发，不占用 timerfd
+    std::weak_ptr<TimingWheel> weakSelf(shared_from_this());
+    m_loop->runEvery(1.0, [weakSelf]() {
+        std::shared_ptr<TimingWheel> self = weakSelf.lock();
+        if (self)
+        {
+            self->onTick();
+        }
+    }, kTickSlackSeconds);
+}
+
+void TimingWheel::add(const TcpConnectionPtr& conn)
+{
+    m_loop->assertInLoopThread();
+    // 挂到离当前最远的桶，也就是 idleSeconds 秒后才会被检查
+    size_t slot = (m_cursor + m_idleSeconds) % m_buckets.size();
+    m_buckets[slot].push_back(conn);
+}
+
+void TimingWheel::onTick()
+{
+    m_loop->assertInLoopThread();
+    m_cursor = (m_cursor + 1) % m_buckets.size();
+
+    // 把到期的桶整个换出来，交换后原来的桶拿到的是清空过的 m_expiring 的容量
+    m_expiring.swap(m_buckets[m_cursor]);
+
+    const MonoTime now = MonoTime::now();
+    const int64_t timeoutUs = static_cast<int64_t>(m_idleSeconds) * Timestamp::kMicroSecondsPerSecond;
+
+    for (const WeakConnection& weakConn : m_expiring)
+    {
+        TcpConnectionPtr conn = weakConn.lock();
+        if (!conn || !conn->connected())
+        {
+            continue; // 连接已经断开，直接丢弃
+        }
+
+        int64_t idleUs = microSecondsBetween(now, conn->lastActiveTime());
+        int64_t remainingUs = timeoutUs - idleUs;
+        if (remainingUs <= 0)
+        {
+            LOG_INFO << "TimingWheel: connection " << conn->name()
+                     << " idle for " << idleUs / Timestamp::kMicroSecondsPerSecond << "s, closing";
+            conn->forceClose();
+        }
+        else
+        {
+            // 期间有过读写，按剩余时间 (向上取整到秒) 重新挂到后面的桶
+            int64_t ticks = (remainingUs + Timestamp::kMicroSecondsPerSecond - 1) / Timestamp::kMicroSecondsPerSecond;
+            if (ticks > m_idleSeconds)
+            {
+                ticks = m_idleSeconds;
+            }
+            size_t slot = (m_cursor + static_cast<size_t>(ticks)) % m_buckets.size();
+            m_buckets[slot].push_back(weakConn);
+        }
+    }
+    m_expiring.clear();
+}
@@ -0,0 +1,51 @@
+// net/TimingWheel.h
+
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include "base/noncopyable.h"
+#include "Callbacks.h"
+
+#include <memory>
+#include <vector>
+
+class EventLoop;
+
+/**
+ * @brief 每个 EventLoop 一个的时间轮，用于踢掉空闲连接。
+ * 环形数组共 idleSeconds + 1 个桶，每秒 tick 一次，每次只处理一个桶。
+ * 桶里存的是 weak_ptr<TcpConnection>，不延长连接的生命周期。
+ *
+ * 连接活跃时并不在桶之间搬家，只是更新自己的 lastActiveTime (O(1))；
+ * 等它所在的桶到期时再检查一次：真的空闲满了就关闭，否则按剩余时间挂到后面的桶里。
+ * 这样每个连接在一个超时周期内最多被检查常数次，百万连接也只是每秒扫一个桶。
+ * 所有操作都在所属 loop 线程中进行，不需要加锁。
+ */
+class TimingWheel : noncopyable, public std::enable_shared_from_this<TimingWheel>
+{
+public:
+    TimingWheel(EventLoop* loop, int idleSeconds);
+    ~TimingWheel();
+
+    // 在 loop 线程中调用，注册每秒一次的 tick 定时器
+    void start();
+
+    // 新连接建立后加入时间轮 (loop 线程)
+    void add(const TcpConnectionPtr& conn);
+
+    int idleSeconds() const { return m_idleSeconds; }
+
+private:
+    using WeakConnection = std::weak_ptr<TcpConnection>;
+    using Bucket = std::vector<WeakConnection>;
+
+    void onTick();
+
+    EventLoop* m_loop;
+    const int m_idleSeconds;
+    std::vector<Bucket> m_buckets;
+    Bucket m_expiring;   // 复用的临时桶，避免每秒重新分配
+    size_t m_cursor;     // 当前 tick 所在的桶
+};
+
+#endif
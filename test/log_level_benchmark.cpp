@@ -0,0 +1,84 @@
+// test/log_level_benchmark.cpp
+// 被级别过滤掉的日志语句的成本：
+//   singleton+read  : 原来的判断 (函数内静态单例的初始化检查 + 读成员)，在这里复刻作为对照
+//   LOG_DEBUG       : 运行期关闭 (全局级别 INFO)，一次 relaxed 原子读
+//   LOG_INFO+module : 另一个模块的覆盖把阈值降到 DEBUG，全局级别 ERROR，
+//                     本文件的 INFO 要查模块表才能确定被关闭 (慢路径)
+//   + override      : 覆盖改为 INFO，本文件的 DEBUG 低于阈值，又只有一次原子读
+// 编译期关闭 (MYMUDUO_MIN_LOG_LEVEL) 的语句整条被删除，没有可测的成本；
+// 这里强制为 0，让 Release 构建中的 LOG_DEBUG 也保留运行期判断。
+// 用法: log_level_benchmark [iterations]，默认 100000000
+
+#define MYMUDUO_MIN_LOG_LEVEL 0
+#include "base/Logger.h"
+#include "base/MonoTime.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+// 原来的 Logger::getInstance().logLevel()；非平凡构造函数，与 Logger 一样需要动态初始化
+struct OldLogger
+{
+    OldLogger() : level(INFO) { g_constructed = true; }
+
+    int level;
+    static bool g_constructed;
+
+    static OldLogger& getInstance()
+    {
+        static OldLogger logger;
+        return logger;
+    }
+};
+
+bool OldLogger::g_constructed = false;
+
+void report(const char* name, long iterations, MonoTime start)
+{
+    MonoTime end = MonoTime::now();
+    printf("%-16s %6.2f ns/statement\n", name,
+           static_cast<double>(end.nanoSeconds() - start.nanoSeconds()) / iterations);
+}
+
+} // namespace
+
+// 语句直接展开在循环里 (而不是放进 lambda 调用)，与真实调用点一样内联
+#define RUN(name, statement)                     \
+    do                                           \
+    {                                            \
+        MonoTime start = MonoTime::now();        \
+        for (long i = 0; i < iterations; ++i)    \
+        {                                        \
+            statement;                           \
+        }                                        \
+        report(name, iterations, start);         \
+    } while (0)
+
+int main(int argc, char* argv[])
+{
+    long iterations = argc > 1 ? atol(argv[1]) : 100000000L;
+    Logger& logger = Logger::getInstance();
+    logger.setLogLevel(INFO);
+
+    long sink = 0;
+    // asm 屏障让每次判断都重新经过单例访问，不被提到循环外
+    RUN("singleton+read", asm volatile("" ::: "memory");
+        if (OldLogger::getInstance().level <= DEBUG) { sink += i; });
+
+    RUN("LOG_DEBUG", LOG_DEBUG << "disabled " << i);
+
+    logger.setModuleLevel("TcpConnection", DEBUG);
+    logger.setLogLevel(ERROR);
+    RUN("LOG_INFO+module", LOG_INFO << "disabled " << i);
+
+    logger.setModuleLevel("TcpConnection", INFO);
+    RUN("+ override", LOG_DEBUG << "disabled " << i);
+
+    logger.clearModuleLevel("TcpConnection");
+    logger.setLogLevel(INFO);
+    printf("(sink %ld)\n", sink);
+    return 0;
+}
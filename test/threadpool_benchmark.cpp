@@ -0,0 +1,109 @@
+// test/threadpool_benchmark.cpp
+// 大量细粒度任务的吞吐，对比 ThreadPool (一把锁的共享队列 / 无锁 MpmcQueue) 与 WorkStealingPool：
+//   external : 主线程提交 N 个几乎不做事的任务
+//   spawn    : 一个根任务在 worker 中递归派生二叉树形的子任务 (共约 N 个)
+// 计时从第一次提交到 shutdown 返回 (全部执行完)。
+// 用法: threadpool_benchmark [tasks] [threads]，默认 1000000 个任务、4 个线程
+
+#include "base/ThreadPool.h"
+#include "base/WorkStealingPool.h"
+#include "base/Logger.h"
+#include "base/MonoTime.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace
+{
+
+std::atomic<long> g_completed(0);
+long g_tasks = 0;
+
+void report(const char* pool, const char* workload, long tasks, MonoTime start)
+{
+    MonoTime end = MonoTime::now();
+    double seconds = static_cast<double>(end.nanoSeconds() - start.nanoSeconds()) / 1e9;
+    printf("%-16s %-9s %9ld tasks %8.3f s %12.0f tasks/s\n",
+           pool, workload, tasks, seconds, static_cast<double>(tasks) / seconds);
+}
+
+// 启动前的配置，例如 ThreadPool::setQueueType
+template<typename Pool>
+void noSetup(Pool&) {}
+
+// spawn 负载在 worker 中提交任务，有界队列满了会让所有 worker 都阻塞在 addTask 上，容量要装得下全部任务
+void useMpmcQueue(ThreadPool& pool)
+{
+    pool.setQueueType(ThreadPool::QueueType::kMpmcQueue, static_cast<size_t>(g_tasks));
+}
+
+template<typename Pool>
+void runExternal(const char* name, int threads, long tasks, void (*setup)(Pool&) = noSetup<Pool>)
+{
+    g_completed = 0;
+    Pool pool(threads, "Bench");
+    setup(pool);
+    pool.start();
+    MonoTime start = MonoTime::now();
+    for (long i = 0; i < tasks; ++i)
+    {
+        pool.addTask([]() { g_completed.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.shutdown();
+    report(name, "external", g_completed.load(), start);
+}
+
+template<typename Pool>
+void spawn(Pool& pool, int depth)
+{
+    g_completed.fetch_add(1, std::memory_order_relaxed);
+    if (depth > 0)
+    {
+        pool.addTask([&pool, depth]() { spawn(pool, depth - 1); });
+        pool.addTask([&pool, depth]() { spawn(pool, depth - 1); });
+    }
+}
+
+template<typename Pool>
+void runSpawn(const char* name, int threads, long tasks, void (*setup)(Pool&) = noSetup<Pool>)
+{
+    int depth = 0;
+    while ((2L << (depth + 1)) - 1 <= tasks)
+    {
+        ++depth;
+    }
+    g_completed = 0;
+    Pool pool(threads, "Bench");
+    setup(pool);
+    pool.start();
+    MonoTime start = MonoTime::now();
+    pool.addTask([&pool, depth]() { spawn(pool, depth); });
+    // ThreadPool::shutdown 在队列暂时为空时就会让 worker 退出，等整棵树执行完再关闭
+    long expected = (2L << depth) - 1;
+    while (g_completed.load() < expected)
+    {
+        std::this_thread::yield();
+    }
+    pool.shutdown();
+    report(name, "spawn", g_completed.load(), start);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    long tasks = argc > 1 ? atol(argv[1]) : 1000000L;
+    g_tasks = tasks;
+    int threads = argc > 2 ? atoi(argv[2]) : 4;
+    Logger::getInstance().setLogLevel(ERROR); // 不让 worker 启停日志混进结果
+
+    runExternal<ThreadPool>("ThreadPool", threads, tasks);
+    runExternal<ThreadPool>("ThreadPool(mpmc)", threads, tasks, useMpmcQueue);
+    runExternal<WorkStealingPool>("WorkStealingPool", threads, tasks);
+    runSpawn<ThreadPool>("ThreadPool", threads, tasks);
+    runSpawn<ThreadPool>("ThreadPool(mpmc)", threads, tasks, useMpmcQueue);
+    runSpawn<WorkStealingPool>("WorkStealingPool", threads, tasks);
+    return 0;
+}
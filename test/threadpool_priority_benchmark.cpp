@@ -0,0 +1,116 @@
+// test/threadpool_priority_benchmark.cpp
+// 后台任务洪峰下请求任务的尾延迟：先一次性提交 B 个后台任务 (每个忙等 200us)，
+// 再每隔 1ms 提交一个请求任务 (几乎不做事)，共 R 个。请求延迟 = 开始执行时刻 - 提交时刻。
+//   fifo             : 默认的 LockQueue，所有任务先进先出
+//   priority         : kPriorityQueue，请求 kHigh、后台 kLow
+//   priority+deadline: 同上，后台任务带 50ms 截止时间，过期的直接丢弃
+// 用法: threadpool_priority_benchmark [background] [requests] [threads]，默认 4000 / 500 / 4
+
+#include "base/ThreadPool.h"
+#include "base/Logger.h"
+#include "base/MonoTime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+const int64_t kBackgroundWorkNs = 200 * 1000;
+const double kBackgroundDeadlineSeconds = 0.05;
+
+std::atomic<long> g_background(0);
+
+void spin(int64_t ns)
+{
+    int64_t end = MonoTime::now().nanoSeconds() + ns;
+    while (MonoTime::now().nanoSeconds() < end)
+    {
+    }
+}
+
+enum class Mode
+{
+    kFifo,
+    kPriority,
+    kPriorityDeadline,
+};
+
+void run(const char* name, Mode mode, int background, int requests, int threads)
+{
+    g_background = 0;
+    ThreadPool pool(threads, "Bench");
+    if (mode != Mode::kFifo)
+    {
+        pool.setQueueType(ThreadPool::QueueType::kPriorityQueue);
+    }
+    pool.start();
+
+    for (int i = 0; i < background; ++i)
+    {
+        ThreadPool::Task task = []() {
+            spin(kBackgroundWorkNs);
+            g_background.fetch_add(1, std::memory_order_relaxed);
+        };
+        if (mode == Mode::kFifo)
+        {
+            pool.addTask(std::move(task));
+        }
+        else
+        {
+            MonoTime deadline = mode == Mode::kPriorityDeadline
+                                    ? addTime(MonoTime::now(), kBackgroundDeadlineSeconds)
+                                    : MonoTime();
+            pool.addTask(std::move(task), ThreadPool::Priority::kLow, deadline);
+        }
+    }
+
+    // 每个请求只由一个任务写自己的槽位，shutdown 之后再读
+    std::vector<int64_t> latencies(requests, 0);
+    for (int i = 0; i < requests; ++i)
+    {
+        int64_t submitNs = MonoTime::now().nanoSeconds();
+        ThreadPool::Task task = [&latencies, i, submitNs]() {
+            latencies[i] = MonoTime::now().nanoSeconds() - submitNs;
+        };
+        if (mode == Mode::kFifo)
+        {
+            pool.addTask(std::move(task));
+        }
+        else
+        {
+            pool.addTask(std::move(task), ThreadPool::Priority::kHigh);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pool.shutdown();
+    ThreadPool::Stats stats = pool.stats();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        size_t index = std::min(latencies.size() - 1, static_cast<size_t>(latencies.size() * p));
+        return static_cast<double>(latencies[index]) / 1000.0;
+    };
+    printf("%-18s request p50 %9.1f us  p99 %9.1f us  max %9.1f us   background run %5ld expired %5lu\n",
+           name, percentile(0.5), percentile(0.99), percentile(1.0),
+           g_background.load(), static_cast<unsigned long>(stats.expiredTasks));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int background = argc > 1 ? atoi(argv[1]) : 4000;
+    int requests = argc > 2 ? atoi(argv[2]) : 500;
+    int threads = argc > 3 ? atoi(argv[3]) : 4;
+    Logger::getInstance().setLogLevel(ERROR); // 不让 worker 启停日志混进结果
+
+    run("fifo", Mode::kFifo, background, requests, threads);
+    run("priority", Mode::kPriority, background, requests, threads);
+    run("priority+deadline", Mode::kPriorityDeadline, background, requests, threads);
+    return 0;
+}
@@ -0,0 +1,202 @@
+// test/timer_benchmark.cpp
+// EventLoop 定时器 (runAfter / runEvery / cancel) 的微基准。
+// 对 1k ~ maxTimers 个未到期定时器分别测三种负载：
+//   add-heavy    : 连续添加到期时间随机分布的定时器，统计每次 runAfter 的开销
+//                  (按到期时间递增添加是堆的最好情况，不代表真实负载)
+//   cancel-heavy : 维持 n 个未到期的超时定时器，每个请求"添加新超时 + 取消最旧的超时"
+//                  (典型的 per-request deadline：绝大多数超时在触发前就被取消)
+//   expire-heavy : n 个定时器分布在 200ms 内到期，统计 loop 线程 CPU 和触发抖动
+//                  (实际触发时间 - 请求的到期时间)，精确定时器与 1ms slack 各测一次
+// 用法: timer_benchmark [maxTimers]，默认 1000000
+
+#include "EventLoop.h"
+#include "TimerId.h"
+#include "base/MonoTime.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const int kCancelRounds = 1000000;
+const double kFarFuture = 3600.0;    // add/cancel 负载中的定时器不会真正触发
+const double kAddSpread = 60.0;      // add-heavy 的到期时间在 kFarFuture 之后的这段时间内均匀分布
+const double kExpireWindow = 0.2;    // expire-heavy 中定时器分布的时间窗口
+const double kExpireStart = 0.05;    // 再加上按 add-heavy 实测开销估算的添加耗时
+
+int64_t threadCpuNs()
+{
+    struct timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * MonoTime::kNanoSecondsPerSecond + ts.tv_nsec;
+}
+
+void noop() {}
+
+// 返回每次 runAfter 的纳秒数，供 expire-heavy 估算添加 n 个定时器要多久
+double benchAdd(EventLoop* loop, int n)
+{
+    std::vector<TimerId> ids;
+    ids.reserve(n);
+    // 随机数在计时之前生成好，固定种子使各次运行可比
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> spread(0.0, kAddSpread);
+    std::vector<double> delays(n);
+    for (double& delay : delays)
+    {
+        delay = kFarFuture + spread(rng);
+    }
+
+    MonoTime start = MonoTime::now();
+    for (int i = 0; i < n; ++i)
+    {
+        ids.push_back(loop->runAfter(delays[i], noop));
+    }
+    MonoTime end = MonoTime::now();
+
+    MonoTime cancelStart = MonoTime::now();
+    for (const TimerId& id : ids)
+    {
+        loop->cancel(id);
+    }
+    MonoTime cancelEnd = MonoTime::now();
+
+    double addNs = static_cast<double>(end.nanoSeconds() - start.nanoSeconds()) / n;
+    printf("%-14s n=%-8d add %8.1f ns/op   cancel %8.1f ns/op\n", "add-heavy", n, addNs,
+           static_cast<double>(cancelEnd.nanoSeconds() - cancelStart.nanoSeconds()) / n);
+    return addNs;
+}
+
+void benchCancel(EventLoop* loop, int n)
+{
+    // 环形保存 n 个未到期的超时，每个新请求取消最旧的那个
+    std::vector<TimerId> ids;
+    ids.reserve(n);
+    for (int i = 0; i < n; ++i)
+    {
+        ids.push_back(loop->runAfter(kFarFuture + i * 1e-6, noop));
+    }
+
+    MonoTime start = MonoTime::now();
+    for (int i = 0; i < kCancelRounds; ++i)
+    {
+        size_t slot = static_cast<size_t>(i % n);
+        loop->cancel(ids[slot]);
+        ids[slot] = loop->runAfter(kFarFuture + i * 1e-6, noop);
+    }
+    MonoTime end = MonoTime::now();
+
+    for (const TimerId& id : ids)
+    {
+        loop->cancel(id);
+    }
+
+    printf("%-14s n=%-8d add+cancel %8.1f ns/op\n", "cancel-heavy", n,
+           static_cast<double>(end.nanoSeconds() - start.nanoSeconds()) / kCancelRounds);
+}
+
+struct ExpireSample
+{
+    MonoTime when;
+    int64_t lateNs;
+};
+
+struct ExpireRun
+{
+    EventLoop* loop;
+    std::vector<ExpireSample> samples;
+    int remaining;
+};
+
+int64_t percentile(const std::vector<int64_t>& sorted, double p)
+{
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
+
+void benchExpire(int n, double slack, double addNs)
+{
+    EventLoop loop;
+    ExpireRun run;
+    run.loop = &loop;
+    run.samples.resize(n);
+    run.remaining = n;
+
+    int64_t cpuStart = threadCpuNs();
+    // 第一个定时器要在全部添加完之后才到期，否则抖动里混进的是添加耗时
+    double setupSeconds = 2.0 * addNs * n / MonoTime::kNanoSecondsPerSecond;
+    MonoTime base = addTime(MonoTime::now(), kExpireStart + setupSeconds);
+    for (int i = 0; i < n; ++i)
+    {
+        ExpireSample* sample = &run.samples[i];
+        sample->when = addTime(base, kExpireWindow * i / n);
+        ExpireRun* runPtr = &run;
+        loop.runAt(sample->when, [runPtr, sample]() {
+            sample->lateNs = MonoTime::now().nanoSeconds() - sample->when.nanoSeconds();
+            if (--runPtr->remaining == 0)
+            {
+                runPtr->loop->quit();
+            }
+        }, slack);
+    }
+    loop.loop();
+    int64_t cpuNs = threadCpuNs() - cpuStart;
+
+    std::vector<int64_t> late;
+    late.reserve(n);
+    for (const ExpireSample& sample : run.samples)
+    {
+        late.push_back(sample.lateNs);
+    }
+    std::sort(late.begin(), late.end());
+
+    char name[32];
+    snprintf(name, sizeof name, "expire(%.0fms)", slack * 1000);
+    printf("%-14s n=%-8d cpu %8.1f ns/op   jitter us p50 %6.1f p99 %6.1f p99.9 %6.1f max %7.1f\n",
+           name, n, static_cast<double>(cpuNs) / n,
+           percentile(late, 0.5) / 1e3, percentile(late, 0.99) / 1e3,
+           percentile(late, 0.999) / 1e3, late.back() / 1e3);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int maxTimers = argc > 1 ? atoi(argv[1]) : 1000000;
+    if (MonoTime::enableTsc())
+    {
+        printf("MonoTime: rdtsc\n");
+    }
+
+    std::vector<int> sizes;
+    std::vector<double> addNs;
+    for (int n = 1000; n <= maxTimers; n *= 10)
+    {
+        sizes.push_back(n);
+    }
+
+    {
+        // add/cancel 都在 loop 线程中直接执行，不需要运行 loop
+        EventLoop loop;
+        for (int n : sizes)
+        {
+            addNs.push_back(benchAdd(&loop, n));
+        }
+        for (int n : sizes)
+        {
+            benchCancel(&loop, n);
+        }
+    }
+
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        benchExpire(sizes[i], 0.0, addNs[i]);
+        benchExpire(sizes[i], 0.001, addNs[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+// tests/TestCheck.h
+
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+
+// 测试用的断言：与 assert 不同，定义了 NDEBUG 时照样求值和检查，
+// 只在检查里用到的返回值也就不会变成未使用的变量
+#define CHECK(cond) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            abort(); \
+        } \
+    } while (0)
+
+#endif
@@ -0,0 +1,90 @@
+// tests/test_auto_cork.cpp
+// 验证 auto-cork：消息回调里先 send 头再 send 体，开启后每条回复只产生一次 write
+
+#include "net/TcpServer.h"
+#include "net/TcpConnection.h"
+#include "net/EventLoop.h"
+#include "net/InetAddress.h"
+#include "net/Buffer.h"
+#include "base/Logger.h"
+#include "base/Thread.h"
+
+#include <cassert>
+#include <cstring>
+#include <future>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+// 不开 auto-cork 时头和体分两次 write，第二个小包会撞上 Nagle + 延迟 ACK，每轮约 40ms
+const int kRounds = 50;
+const char kHeader[] = "HDR:";
+const int kBodySize = 32;
+
+// 返回服务端处理 kRounds 个请求总共调用了多少次 write
+uint64_t runRounds(uint16_t port, bool autoCork)
+{
+    EventLoop loop;
+    InetAddress addr(port);
+    TcpServer server(&loop, addr, "CorkServer");
+    server.enableStats(true);
+    server.setAutoCork(autoCork);
+    server.setConnectionCallback([](const TcpConnectionPtr&) {});
+    server.setMessageCallback([](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        std::string body = buf->retrieveAllAsString();
+        conn->send(kHeader);
+        conn->send(body);
+    });
+    server.start();
+
+    uint64_t writeCalls = 0;
+    Thread client([&]() {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in serverAddr = *addr.getSockAddr();
+        if (::connect(fd, (sockaddr*)&serverAddr, sizeof serverAddr) < 0)
+        {
+            LOG_FATAL << "connect failed";
+        }
+
+        char body[kBodySize];
+        memset(body, 'b', sizeof body);
+        const size_t replySize = sizeof(kHeader) - 1 + kBodySize;
+        char buf[128];
+        for (int i = 0; i < kRounds; ++i)
+        {
+            ::write(fd, body, sizeof body);
+            size_t got = 0;
+            while (got < replySize)
+            {
+                ssize_t n = ::read(fd, buf + got, replySize - got);
+                assert(n > 0);
+                got += n;
+            }
+            assert(memcmp(buf, kHeader, sizeof(kHeader) - 1) == 0);
+        }
+
+        // 先在 baseLoop 中读出统计，再关闭连接
+        std::promise<uint64_t> result;
+        loop.runInLoop([&]() {
+            result.set_value(server.totalStats().writeCalls);
+            loop.quit();
+        });
+        writeCalls = result.get_future().get();
+        ::close(fd);
+    }, "CorkClient");
+    client.start();
+
+    loop.loop();
+    client.join();
+    return writeCalls;
+}
+
+int main()
+{
+    uint64_t plain = runRounds(9984, false);
+    uint64_t corked = runRounds(9985, true);
+    LOG_INFO << "write calls for " << kRounds << " replies: plain=" << plain << " auto-cork=" << corked;
+    assert(plain >= 2 * kRounds);
+    assert(corked == kRounds);
+    return 0;
+}
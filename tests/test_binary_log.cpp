@@ -0,0 +1,198 @@
+// tests/test_binary_log.cpp
+// 验证二进制日志：同样的参数经 BINLOG_INFO 记录、binlog::decode 还原后，与 LOG_INFO 的文本一致；
+// 多个线程的记录一条不少、各自有序；
+// 写线程被卡住 (输出文件是一个还没人读的 FIFO) 时，环满后按 Logger 的溢出策略丢弃并计数，
+// "解码出的条数 + droppedMessages() 的增量" 等于记录的条数
+
+#include "base/BinaryLog.h"
+#include "base/Logger.h"
+#include "TestCheck.h"
+
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+std::vector<std::string> g_textLines;
+
+void capture(const char* msg, size_t len)
+{
+    g_textLines.emplace_back(msg, len - 1); // 去掉结尾换行
+}
+
+// 去掉时间前缀和 "文件名:行号 "，只留级别和正文
+std::string body(const std::string& line)
+{
+    size_t level = line.find('[');
+    size_t source = line.find(' ', level);
+    size_t text = line.find(' ', source + 1);
+    return line.substr(level, source - level) + line.substr(text);
+}
+
+// 把 binlog 解码成文本，返回行数；lineCheck 检查每一行
+template<typename LineCheck>
+size_t decodeFile(const char* binFile, LineCheck lineCheck)
+{
+    char textFile[] = "/tmp/test_binary_log_text_XXXXXX";
+    int fd = ::mkstemp(textFile);
+    CHECK(fd >= 0);
+    ::close(fd);
+    FILE* in = ::fopen(binFile, "rb");
+    FILE* out = ::fopen(textFile, "w");
+    CHECK(in != nullptr && out != nullptr);
+    bool ok = binlog::decode(in, out);
+    CHECK(ok);
+    ::fclose(in);
+    ::fclose(out);
+
+    std::ifstream decoded(textFile);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(decoded, line))
+    {
+        lineCheck(line);
+        ++lines;
+    }
+    ::unlink(textFile);
+    return lines;
+}
+
+// 写线程打开 FIFO 时阻塞，在有人读之前不会再取环；环写满后的记录按 kDropNewest 立即丢弃
+void testOverflow()
+{
+    const std::string fifo = "/tmp/test_binary_log_fifo_" + std::to_string(::getpid());
+    int ret = ::mkfifo(fifo.c_str(), 0600);
+    CHECK(ret == 0);
+    BinaryLogger::getInstance().setFile(fifo);
+    Logger& logger = Logger::getInstance();
+    logger.setOverflowPolicy(Logger::OverflowPolicy::kDropNewest);
+
+    const int kMessages = 50000; // 每条约 40 字节，远超 256KB 的线程环
+    uint64_t droppedBefore = logger.droppedMessages();
+    for (int i = 0; i < kMessages; ++i)
+    {
+        BINLOG_INFO << "binlog-overflow seq=" << i;
+    }
+    uint64_t dropped = logger.droppedMessages() - droppedBefore;
+    CHECK(dropped > 0);
+
+    // 读走 FIFO 的内容，写线程继续；换文件时关闭 FIFO，读端看到 EOF
+    std::string content;
+    std::thread reader([&content, &fifo]() {
+        int fd = ::open(fifo.c_str(), O_RDONLY | O_CLOEXEC);
+        CHECK(fd >= 0);
+        char buf[65536];
+        ssize_t n;
+        while ((n = ::read(fd, buf, sizeof buf)) > 0)
+        {
+            content.append(buf, n);
+        }
+        ::close(fd);
+    });
+    BinaryLogger::getInstance().flush();
+    char binFile[] = "/tmp/test_binary_log_overflow_XXXXXX";
+    int fd = ::mkstemp(binFile);
+    CHECK(fd >= 0);
+    BinaryLogger::getInstance().setFile(binFile);
+    reader.join();
+    ssize_t written = ::write(fd, content.data(), content.size());
+    CHECK(written == static_cast<ssize_t>(content.size()));
+    ::close(fd);
+    logger.setOverflowPolicy(Logger::OverflowPolicy::kBlock);
+
+    // 留下的是前面连续的一段和之后零星写进去的记录，序号递增
+    int last = -1;
+    size_t lines = decodeFile(binFile, [&last](const std::string& line) {
+        size_t pos = line.find("binlog-overflow seq=");
+        CHECK(pos != std::string::npos);
+        int seq = -1;
+        int matched = sscanf(line.c_str() + pos, "binlog-overflow seq=%d", &seq);
+        CHECK(matched == 1 && seq > last);
+        last = seq;
+    });
+    CHECK(lines + dropped == static_cast<size_t>(kMessages));
+    ::unlink(binFile);
+    ::unlink(fifo.c_str());
+}
+
+int main()
+{
+    char binFile[] = "/tmp/test_binary_log_XXXXXX";
+    int fd = ::mkstemp(binFile);
+    CHECK(fd >= 0);
+    ::close(fd);
+    BinaryLogger::getInstance().setFile(binFile);
+
+    // 同一组参数分别以文本和二进制方式各记一次
+    Logger::getInstance().setOutput(capture);
+    const std::string peer("127.0.0.1:54321");
+    const void* ptr = reinterpret_cast<const void*>(0xdeadbeef);
+    for (int i = 0; i < 3; ++i)
+    {
+        LOG_INFO << "request " << i << " from " << peer << " took " << 0.125 * i << "ms";
+        BINLOG_INFO << "request " << i << " from " << peer << " took " << 0.125 * i << "ms";
+    }
+    LOG_ERROR << INT_MIN << ' ' << ULLONG_MAX << ' ' << -7L << ' ' << 3.14f << ' ' << true << ptr
+              << static_cast<const char*>(nullptr) << static_cast<short>(-5) << 65535u;
+    BINLOG_ERROR << INT_MIN << ' ' << ULLONG_MAX << ' ' << -7L << ' ' << 3.14f << ' ' << true << ptr
+                 << static_cast<const char*>(nullptr) << static_cast<short>(-5) << 65535u;
+    Logger::getInstance().setOutput(nullptr);
+
+    // 多线程
+    const int kThreads = 4;
+    const int kMessagesPerThread = 20000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < kMessagesPerThread; ++i)
+            {
+                BINLOG_INFO << "binlog-test thread=" << t << " seq=" << i;
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    BinaryLogger::getInstance().flush();
+
+    // 解码
+    size_t textIndex = 0;
+    std::vector<int> next(kThreads, 0);
+    std::string now = Timestamp::now().toString();
+    decodeFile(binFile, [&](const std::string& line) {
+        // 时间前缀由文件头的时间基准还原，不会晚于现在
+        CHECK(line[19] == '.' && line.substr(0, 19) <= now);
+        CHECK(line.find("test_binary_log.cpp:") != std::string::npos);
+        if (textIndex < g_textLines.size())
+        {
+            CHECK(body(line) == body(g_textLines[textIndex]));
+            ++textIndex;
+            return;
+        }
+        size_t pos = line.find("binlog-test thread=");
+        CHECK(pos != std::string::npos);
+        int t = -1, seq = -1;
+        int matched = sscanf(line.c_str() + pos, "binlog-test thread=%d seq=%d", &t, &seq);
+        CHECK(matched == 2 && t >= 0 && t < kThreads);
+        CHECK(seq == next[t]);
+        ++next[t];
+    });
+    CHECK(textIndex == g_textLines.size());
+    for (int t = 0; t < kThreads; ++t)
+    {
+        CHECK(next[t] == kMessagesPerThread);
+    }
+
+    ::unlink(binFile);
+
+    testOverflow();
+    LOG_INFO << "binary log decoded " << textIndex + kThreads * kMessagesPerThread << " lines";
+    return 0;
+}
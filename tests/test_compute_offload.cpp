@@ -0,0 +1,160 @@
+// tests/test_compute_offload.cpp
+// 验证 ThreadPool::submit(...).then(loop, cb)：
+// - CompletionQueue 只有由空变为非空的那次 push 返回 true，drain 按放入顺序执行
+// - get() 阻塞取得结果，结果可以是只能移动的类型
+// - 从 loop 线程提交大量任务，每个 continuation 都在 loop 线程上执行恰好一次，结果正确
+// - 任务完成之后才注册 then，continuation 同样送到 loop 线程
+// - shutdown 之后提交：任务不执行，wait() 返回、abandoned() 为真，then 不执行，捕获的资源被释放；
+//   对这样的句柄调用 get() 终止程序 (在子进程里验证)
+
+#include "net/EventLoop.h"
+#include "base/ThreadPool.h"
+#include "base/TaskFuture.h"
+#include "base/Logger.h"
+#include "TestCheck.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+const int kTasks = 20000;
+
+class RecordCompletion : public Completion
+{
+public:
+    RecordCompletion(std::vector<int>* order, int id) : m_order(order), m_id(id) {}
+    void complete() override { m_order->push_back(m_id); }
+
+private:
+    std::vector<int>* m_order;
+    int m_id;
+};
+
+void testCompletionQueue()
+{
+    std::vector<int> order;
+    RecordCompletion a(&order, 1), b(&order, 2), c(&order, 3);
+    CompletionQueue queue;
+    bool wasEmpty = queue.push(&a);
+    CHECK(wasEmpty);
+    wasEmpty = queue.push(&b);
+    CHECK(!wasEmpty);
+    wasEmpty = queue.push(&c);
+    CHECK(!wasEmpty);
+    size_t drained = queue.drain();
+    CHECK(drained == 3);
+    CHECK((order == std::vector<int>{1, 2, 3}));
+    wasEmpty = queue.push(&a); // 取空后重新由空变为非空
+    CHECK(wasEmpty);
+    drained = queue.drain();
+    CHECK(drained == 1);
+}
+
+void testGet(ThreadPool& pool)
+{
+    int answer = pool.submit([]() { return 6 * 7; }).get();
+    CHECK(answer == 42);
+    std::unique_ptr<int> ptr = pool.submit([]() { return std::make_unique<int>(7); }).get();
+    CHECK(ptr && *ptr == 7);
+
+    int touched = 0;
+    TaskFuture<void> done = pool.submit([&touched]() { touched = 1; });
+    done.get();
+    CHECK(touched == 1 && done.ready());
+}
+
+// 线程池已经关闭
+void testAbandoned(ThreadPool& pool, EventLoop* loop)
+{
+    auto captured = std::make_shared<int>(1);
+    bool ran = false;
+    {
+        TaskFuture<int> future = pool.submit([captured, &ran]() {
+            ran = true;
+            return *captured;
+        });
+        future.wait();
+        CHECK(future.ready() && future.abandoned() && !ran);
+        future.then(loop, [captured](int) { abort(); });
+        CHECK(captured.use_count() == 2); // 回调不会执行，注册时即释放；任务还由句柄持有的状态保管
+    }
+    CHECK(captured.use_count() == 1); // 句柄销毁后状态释放，没有泄漏
+
+    TaskFuture<void> dropped = pool.submit([]() {});
+    dropped.wait();
+    CHECK(dropped.abandoned());
+
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        ::close(STDERR_FILENO);
+        pool.submit([]() { return 1; }).get();
+        _exit(0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+}
+
+int main()
+{
+    testCompletionQueue();
+
+    ThreadPool pool(4, "Compute");
+    pool.start();
+    testGet(pool);
+
+    EventLoop loop;
+    long long sum = 0;
+    int completed = 0;
+    int late = 0;
+    auto finishIfDone = [&]() {
+        if (completed == kTasks && late == 1)
+        {
+            loop.quit();
+        }
+    };
+
+    // 在 loop 运行起来之后、事件处理中提交，与真实的 IO 回调一致
+    loop.runAfter(0.0, [&]() {
+        for (int i = 0; i < kTasks; ++i)
+        {
+            pool.submit([i]() { return static_cast<long long>(i) * i; })
+                .then(&loop, [&](long long square) {
+                    CHECK(loop.isInLoopThread());
+                    sum += square;
+                    ++completed;
+                    finishIfDone();
+                });
+        }
+
+        // 先等任务结束再注册 then
+        TaskFuture<void> future = pool.submit([]() {});
+        future.wait();
+        future.then(&loop, [&]() {
+            CHECK(loop.isInLoopThread());
+            ++late;
+            finishIfDone();
+        });
+    });
+    loop.runAfter(10.0, []() {
+        LOG_ERROR << "compute offload test timed out";
+        abort();
+    });
+    loop.loop();
+
+    long long expected = 0;
+    for (int i = 0; i < kTasks; ++i)
+    {
+        expected += static_cast<long long>(i) * i;
+    }
+    CHECK(completed == kTasks);
+    CHECK(sum == expected);
+    pool.shutdown();
+    testAbandoned(pool, &loop);
+    LOG_INFO << "compute offload ok";
+    return 0;
+}
@@ -0,0 +1,307 @@
+// tests/test_cross_thread_send.cpp
+// 验证跨线程 send：
+// - 多个 ThreadPool worker 并发回复同一个连接，每个 worker 内部的顺序不变、字节不丢
+// - worker 中 send 之后紧接着 shutdown：客户端先收到完整的回复，然后才是 EOF
+// - IO 线程被占住时，worker 发出远超环容量的消息也不会阻塞；IO 线程恢复后按顺序全部送达
+// - 同一个 worker 先后向两个 loop 发送，后一个 loop 复用了前一个的地址 (前一个析构时还留着没执行的 drain)：
+//   worker 缓存的旧队列不会被误用，消息照常送达
+
+#include "net/TcpServer.h"
+#include "net/TcpConnection.h"
+#include "net/EventLoop.h"
+#include "net/InetAddress.h"
+#include "net/Buffer.h"
+#include "base/Logger.h"
+#include "base/Thread.h"
+#include "base/ThreadPool.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+const uint16_t kPort = 9986;
+const uint16_t kShutdownPort = 9987;
+const uint16_t kBlockedPort = 9989;
+const uint16_t kReusePort = 9990;
+const int kWorkers = 4;
+const int kMessagesPerWorker = 5000; // 超过环的容量，覆盖环满后进入溢出队列的路径
+const int kMessageSize = 16;         // "w%d:%012d\n" 定长
+
+void testConcurrentWorkers()
+{
+    EventLoop loop;
+    InetAddress addr(kPort);
+    TcpServer server(&loop, addr, "CrossThreadServer");
+    server.setThreadNum(1);
+
+    ThreadPool pool(kWorkers, "SendWorker");
+    pool.start();
+
+    server.setConnectionCallback([](const TcpConnectionPtr&) {});
+    server.setMessageCallback([&](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        buf->retrieveAll();
+        for (int w = 0; w < kWorkers; ++w)
+        {
+            pool.addTask([conn, w]() {
+                char msg[kMessageSize + 1];
+                for (int i = 0; i < kMessagesPerWorker; ++i)
+                {
+                    snprintf(msg, sizeof msg, "w%d:%012d\n", w, i);
+                    conn->send(std::string(msg, kMessageSize));
+                }
+            });
+        }
+    });
+    server.start();
+
+    Thread client([&]() {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in serverAddr = *addr.getSockAddr();
+        if (::connect(fd, (sockaddr*)&serverAddr, sizeof serverAddr) < 0)
+        {
+            LOG_FATAL << "connect failed";
+        }
+        ssize_t written = ::write(fd, "go", 2);
+        CHECK(written == 2);
+
+        const size_t total = static_cast<size_t>(kWorkers) * kMessagesPerWorker * kMessageSize;
+        std::string received;
+        char buf[65536];
+        while (received.size() < total)
+        {
+            ssize_t n = ::read(fd, buf, sizeof buf);
+            CHECK(n > 0);
+            received.append(buf, n);
+        }
+        CHECK(received.size() == total);
+
+        // 不同 worker 的消息可以交错，但同一个 worker 的序号必须递增
+        std::vector<int> next(kWorkers, 0);
+        for (size_t off = 0; off < total; off += kMessageSize)
+        {
+            int w = 0, seq = 0;
+            int matched = sscanf(received.c_str() + off, "w%d:%d", &w, &seq);
+            CHECK(matched == 2 && w >= 0 && w < kWorkers);
+            CHECK(seq == next[w]);
+            ++next[w];
+        }
+        LOG_INFO << "received " << total << " bytes from " << kWorkers << " workers in order";
+
+        ::close(fd);
+        loop.runInLoop([&]() { loop.quit(); });
+    }, "CrossThreadClient");
+    client.start();
+
+    loop.loop();
+    client.join();
+    pool.shutdown();
+}
+
+void testSendThenShutdown()
+{
+    const size_t kReplySize = 256 * 1024; // 一次写不完，shutdown 时 outputBuffer 里还有数据
+    EventLoop loop;
+    InetAddress addr(kShutdownPort);
+    TcpServer server(&loop, addr, "SendShutdownServer");
+    server.setThreadNum(1);
+
+    ThreadPool pool(1, "ShutdownWorker");
+    pool.start();
+
+    server.setConnectionCallback([](const TcpConnectionPtr&) {});
+    server.setMessageCallback([&](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        buf->retrieveAll();
+        pool.addTask([conn, kReplySize]() {
+            conn->send(std::string(kReplySize, 'r'));
+            conn->shutdown();
+        });
+    });
+    server.start();
+
+    Thread client([&]() {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in serverAddr = *addr.getSockAddr();
+        if (::connect(fd, (sockaddr*)&serverAddr, sizeof serverAddr) < 0)
+        {
+            LOG_FATAL << "connect failed";
+        }
+        ssize_t written = ::write(fd, "go", 2);
+        CHECK(written == 2);
+
+        // 读到 EOF 为止，EOF 之前必须已经收齐
+        size_t received = 0;
+        char buf[65536];
+        while (true)
+        {
+            ssize_t n = ::read(fd, buf, sizeof buf);
+            CHECK(n >= 0);
+            if (n == 0)
+            {
+                break;
+            }
+            for (ssize_t i = 0; i < n; ++i)
+            {
+                CHECK(buf[i] == 'r');
+            }
+            received += static_cast<size_t>(n);
+        }
+        CHECK(received == kReplySize);
+        LOG_INFO << "received " << received << " bytes before EOF";
+
+        ::close(fd);
+        loop.runInLoop([&]() { loop.quit(); });
+    }, "SendShutdownClient");
+    client.start();
+
+    loop.loop();
+    client.join();
+    pool.shutdown();
+}
+
+void testBlockedLoop()
+{
+    const int kMessages = 5000;
+    EventLoop loop;
+    InetAddress addr(kBlockedPort);
+    TcpServer server(&loop, addr, "BlockedLoopServer");
+    server.setThreadNum(1);
+
+    ThreadPool pool(1, "BlockedWorker");
+    pool.start();
+
+    server.setConnectionCallback([](const TcpConnectionPtr&) {});
+    server.setMessageCallback([&](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        buf->retrieveAll();
+        std::atomic<bool> sent(false);
+        pool.addTask([conn, &sent]() {
+            char msg[kMessageSize + 1];
+            for (int i = 0; i < kMessages; ++i)
+            {
+                snprintf(msg, sizeof msg, "b0:%012d\n", i);
+                conn->send(std::string(msg, kMessageSize));
+            }
+            sent = true;
+        });
+        // 在 IO 线程里等 worker 发完：环很快就满了，worker 只能靠溢出队列继续
+        for (int i = 0; i < 5000 && !sent.load(); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        CHECK(sent.load());
+    });
+    server.start();
+
+    Thread client([&]() {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in serverAddr = *addr.getSockAddr();
+        if (::connect(fd, (sockaddr*)&serverAddr, sizeof serverAddr) < 0)
+        {
+            LOG_FATAL << "connect failed";
+        }
+        ssize_t written = ::write(fd, "go", 2);
+        CHECK(written == 2);
+
+        const size_t total = static_cast<size_t>(kMessages) * kMessageSize;
+        std::string received;
+        char buf[65536];
+        while (received.size() < total)
+        {
+            ssize_t n = ::read(fd, buf, sizeof buf);
+            CHECK(n > 0);
+            received.append(buf, n);
+        }
+        for (int i = 0; i < kMessages; ++i)
+        {
+            char expected[kMessageSize + 1];
+            snprintf(expected, sizeof expected, "b0:%012d\n", i);
+            CHECK(received.compare(static_cast<size_t>(i) * kMessageSize, kMessageSize, expected) == 0);
+        }
+        LOG_INFO << "received " << kMessages << " messages sent while the loop was busy";
+
+        ::close(fd);
+        loop.runInLoop([&]() { loop.quit(); });
+    }, "BlockedLoopClient");
+    client.start();
+
+    loop.loop();
+    client.join();
+    pool.shutdown();
+}
+
+// 返回这一轮 loop 的地址
+uintptr_t runReuseRound(ThreadPool& pool, int round)
+{
+    EventLoop loop;
+    InetAddress addr(kReusePort);
+    TcpServer server(&loop, addr, "ReuseServer"); // 连接也在 loop 上，loop 退出后没有人执行 drain
+    TcpConnectionPtr last;
+    server.setConnectionCallback([](const TcpConnectionPtr&) {});
+    server.setMessageCallback([&](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        buf->retrieveAll();
+        last = conn;
+        pool.addTask([conn, round]() { conn->send("round " + std::to_string(round) + "\n"); });
+    });
+    server.start();
+
+    int fd = -1;
+    Thread client([&]() {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in serverAddr = *addr.getSockAddr();
+        if (::connect(fd, (sockaddr*)&serverAddr, sizeof serverAddr) < 0)
+        {
+            LOG_FATAL << "connect failed";
+        }
+        timeval timeout = {5, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout);
+        ssize_t written = ::write(fd, "go", 2);
+        CHECK(written == 2);
+
+        std::string expected = "round " + std::to_string(round) + "\n";
+        std::string received;
+        char buf[64];
+        while (received.size() < expected.size())
+        {
+            ssize_t n = ::read(fd, buf, sizeof buf);
+            CHECK(n > 0);
+            received.append(buf, n);
+        }
+        CHECK(received == expected);
+        loop.runInLoop([&]() { loop.quit(); });
+    }, "ReuseClient");
+    client.start();
+    loop.loop();
+    client.join();
+
+    // loop 已经退出：这次 send 排下的 drain 不会执行，随 loop 一起析构
+    pool.submit([&last]() { last->send(std::string("late\n")); }).wait();
+    ::close(fd);
+    return reinterpret_cast<uintptr_t>(&loop);
+}
+
+void testLoopAddressReuse()
+{
+    ThreadPool pool(1, "ReuseWorker");
+    pool.start();
+    uintptr_t first = runReuseRound(pool, 1);
+    uintptr_t second = runReuseRound(pool, 2);
+    LOG_INFO << "second loop " << (first == second ? "reused" : "did not reuse") << " the first loop's address";
+    pool.shutdown();
+}
+
+int main()
+{
+    testConcurrentWorkers();
+    testSendThenShutdown();
+    testBlockedLoop();
+    testLoopAddressReuse();
+    return 0;
+}
@@ -0,0 +1,87 @@
+// tests/test_elastic_threadpool.cpp
+// 验证 ThreadPool 的弹性模式：
+// - start 只启动 minThreads 个线程
+// - 任务排队时间超过阈值时加线程，但不超过 maxThreads
+// - 所有任务都执行完，排队时间统计有值
+// - 空闲超时后线程退回 minThreads 个
+// - shutdown 之后统计中的线程数为 0
+
+#include "base/ThreadPool.h"
+#include "base/Logger.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+const int kTasks = 40;
+
+// 最多等 timeoutMs，直到 pred 成立
+template<typename Pred>
+bool waitFor(Pred pred, int timeoutMs)
+{
+    for (int i = 0; i < timeoutMs / 10; ++i)
+    {
+        if (pred())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return pred();
+}
+
+int main()
+{
+    ThreadPool pool(8, "Elastic");
+    ThreadPool::ElasticOptions options;
+    options.minThreads = 1;
+    options.maxThreads = 4;
+    options.growWaitUs = 5000;
+    options.growQueueDepth = 8;
+    options.idleTimeoutMs = 200;
+    pool.setElastic(options);
+    pool.start();
+    assert(pool.stats().threads == 1);
+
+    std::atomic<int> done(0);
+    for (int i = 0; i < kTasks; ++i)
+    {
+        pool.addTask([&done]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            ++done;
+        });
+    }
+    assert(waitFor([&]() { return done.load() == kTasks; }, 10000));
+
+    ThreadPool::Stats stats = pool.stats();
+    LOG_INFO << "threads " << stats.threads << " grown " << stats.threadsGrown
+             << " wait max " << stats.queueWaitUsMax << "us";
+    assert(stats.threadsGrown > 0);
+    assert(stats.threads > 1 && stats.threads <= options.maxThreads);
+    assert(waitFor([&]() { return pool.stats().completedTasks == kTasks; }, 1000));
+    assert(stats.queueWaitUsMax > 0);
+    assert(stats.queueWaitUsTotal >= stats.queueWaitUsMax);
+
+    // 没有任务之后，多出来的线程空闲超时退出
+    assert(waitFor([&]() { return pool.stats().threads == options.minThreads; }, 5000));
+    stats = pool.stats();
+    assert(stats.threadsRetired == stats.threadsGrown);
+    assert(stats.idleThreads == 1);
+
+    // 退回之后仍能继续工作，也能再次扩容
+    for (int i = 0; i < kTasks; ++i)
+    {
+        pool.addTask([&done]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            ++done;
+        });
+    }
+    assert(waitFor([&]() { return done.load() == 2 * kTasks; }, 10000));
+    assert(pool.stats().threadsGrown > stats.threadsGrown);
+
+    pool.shutdown();
+    assert(pool.stats().threads == 0);
+    LOG_INFO << "elastic threadpool ok";
+    return 0;
+}
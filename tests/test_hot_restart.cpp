@@ -0,0 +1,279 @@
+// tests/test_hot_restart.cpp
+// 验证热重启 (HotRestart + TcpServer::enableHotRestart / adoptConnection)：
+// 本进程只做客户端，先 fork 出旧进程 (冷启动并 enableHotRestart)，再 fork 出新进程调用 HotRestart::takeover
+// - 交接前后不停地新建连接：监听 fd 一直在 accept，没有一次 connect 被拒绝，每个连接都有回显
+// - 交接时空闲的连接被交给新进程，之后继续回显，回复来自新进程的 pid
+// - 交接时 outputBuffer 里还有数据的连接留在旧进程排空：客户端收全数据、读到 EOF，
+//   旧进程在这之后才退出，退出码为 0
+// - (以 root 运行时) 其它 uid 的进程连上交接用的 unix socket 会被拒绝，拿不到任何 fd，旧进程照常服务
+// 子进程在本进程创建任何线程 (包括 Logger 的写线程) 之前 fork，避免继承被锁住的互斥量
+
+#include "net/TcpServer.h"
+#include "net/TcpConnection.h"
+#include "net/EventLoop.h"
+#include "net/InetAddress.h"
+#include "net/HotRestart.h"
+#include "net/Buffer.h"
+#include "TestCheck.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+const uint16_t kPort = 9988;
+const size_t kBigReplySize = 32 * 1024 * 1024; // 远大于内核收发缓冲区，交接时一定还留在 outputBuffer 里
+
+// 回显时带上 pid，客户端据此判断是哪个进程在服务；"big" 请求回一大块数据
+void runServer(const std::string& path, int readyFd)
+{
+    ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+    EventLoop loop;
+    HotRestart::Inherited inherited = HotRestart::takeover(path);
+    std::unique_ptr<TcpServer> server;
+    if (inherited.ok())
+    {
+        // 旧进程已经停止 accept：这段时间到达的连接只能在 backlog 里排队，拉长这个窗口
+        usleep(100 * 1000);
+        server.reset(new TcpServer(&loop, inherited.listenFds[0], "HotRestartNew"));
+    }
+    else
+    {
+        server.reset(new TcpServer(&loop, InetAddress(kPort), "HotRestartOld"));
+    }
+
+    const std::string pid = std::to_string(::getpid());
+    server->setConnectionCallback([](const TcpConnectionPtr&) {});
+    server->setMessageCallback([pid](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        std::string request = buf->retrieveAllAsString();
+        if (request == "big\n")
+        {
+            conn->send(std::string(kBigReplySize, 'x'));
+        }
+        else
+        {
+            conn->send(pid + " " + request);
+        }
+    });
+    server->setThreadNum(2); // 连接分布在 IO 线程上，交接时由各 IO 线程挑出空闲连接
+    server->start();
+    for (int fd : inherited.connFds)
+    {
+        server->adoptConnection(fd);
+    }
+    if (!inherited.ok())
+    {
+        server->enableHotRestart(path);
+    }
+
+    char ready = inherited.ok() ? 'n' : 'o';
+    ssize_t written = ::write(readyFd, &ready, 1);
+    if (written != 1)
+    {
+        _exit(1);
+    }
+    loop.loop(); // 旧进程排空后退出 loop；新进程由测试结束时 kill
+}
+
+// clientFds 是本进程已经打开的客户端连接，子进程里要关掉，否则本进程 close 之后连接仍然不断。
+// 返回后从 *readyFd 读到一个字节表示子进程已经开始服务
+pid_t forkServer(const std::string& path, const std::vector<int>& clientFds, int* readyFd)
+{
+    int fds[2];
+    int ret = ::pipe(fds);
+    CHECK(ret == 0);
+    pid_t pid = ::fork();
+    CHECK(pid >= 0);
+    if (pid == 0)
+    {
+        ::close(fds[0]);
+        for (int fd : clientFds)
+        {
+            ::close(fd);
+        }
+        runServer(path, fds[1]);
+        _exit(0);
+    }
+    ::close(fds[1]);
+    *readyFd = fds[0];
+    return pid;
+}
+
+// block 为 false 时只检查一下，不等待
+bool waitReady(int readyFd, bool block)
+{
+    if (!block)
+    {
+        pollfd pfd = {readyFd, POLLIN, 0};
+        if (::poll(&pfd, 1, 0) == 0)
+        {
+            return false;
+        }
+    }
+    char ready = 0;
+    ssize_t n = ::read(readyFd, &ready, 1);
+    CHECK(n == 1);
+    ::close(readyFd);
+    return true;
+}
+
+int connectToServer()
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(kPort);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    int ret = ::connect(fd, (sockaddr*)&addr, sizeof addr);
+    CHECK(ret == 0); // 交接过程中也不能出现 ECONNREFUSED
+    // 服务端没有回应时让 read 超时失败，而不是挂住整个测试
+    timeval timeout = {5, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout);
+    return fd;
+}
+
+// 发一行，读回一行，返回回复里的 pid
+std::string echo(int fd, const std::string& line)
+{
+    ssize_t written = ::write(fd, line.data(), line.size());
+    CHECK(written == static_cast<ssize_t>(line.size()));
+    std::string reply;
+    char buf[256];
+    while (reply.empty() || reply.back() != '\n')
+    {
+        ssize_t n = ::read(fd, buf, sizeof buf);
+        CHECK(n > 0);
+        reply.append(buf, n);
+    }
+    size_t space = reply.find(' ');
+    CHECK(space != std::string::npos && reply.substr(space + 1) == line);
+    return reply.substr(0, space);
+}
+
+// 以 nobody 的身份尝试接管，应当被旧进程拒绝
+void testForeignUid(const std::string& path, const std::vector<int>& clientFds)
+{
+    int ret = ::chmod(path.c_str(), 0777); // 让其它用户能连上 socket 文件，由 SO_PEERCRED 把关
+    CHECK(ret == 0);
+    pid_t pid = ::fork();
+    CHECK(pid >= 0);
+    if (pid == 0)
+    {
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+        for (int fd : clientFds)
+        {
+            ::close(fd);
+        }
+        if (::setuid(65534) != 0)
+        {
+            _exit(2);
+        }
+        HotRestart::Inherited inherited = HotRestart::takeover(path);
+        _exit(inherited.ok() || !inherited.connFds.empty() ? 1 : 0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+bool exited(pid_t pid, int* status)
+{
+    return ::waitpid(pid, status, WNOHANG) == pid;
+}
+
+int main()
+{
+    const std::string path = "/tmp/test_hot_restart_" + std::to_string(::getpid()) + ".sock";
+    int readyFd = -1;
+    pid_t oldPid = forkServer(path, {}, &readyFd);
+    waitReady(readyFd, true);
+    const std::string oldId = std::to_string(oldPid);
+
+    int idleFd = connectToServer();
+    std::string id = echo(idleFd, "hello\n");
+    CHECK(id == oldId);
+
+    // 请求一大块回复，只读一点，剩下的堆在旧进程的 outputBuffer 里
+    int busyFd = connectToServer();
+    ssize_t written = ::write(busyFd, "big\n", 4);
+    CHECK(written == 4);
+    char buf[65536];
+    ssize_t n = ::read(busyFd, buf, sizeof buf);
+    CHECK(n > 0);
+    size_t received = static_cast<size_t>(n);
+
+    if (::geteuid() == 0)
+    {
+        testForeignUid(path, {idleFd, busyFd});
+        id = echo(idleFd, "after intruder\n");
+        CHECK(id == oldId);
+    }
+
+    // 新进程启动、接管期间和之后，新连接一个接一个地建立
+    pid_t newPid = forkServer(path, {idleFd, busyFd}, &readyFd);
+    const std::string newId = std::to_string(newPid);
+    int probes = 0;
+    bool newReady = false;
+    int servedByOld = 0;
+    bool servedByNew = false;
+    while (!newReady || !servedByNew || probes < 100)
+    {
+        newReady = newReady || waitReady(readyFd, false);
+        int fd = connectToServer();
+        id = echo(fd, "probe " + std::to_string(probes) + "\n");
+        CHECK(id == oldId || id == newId);
+        servedByOld += id == oldId ? 1 : 0;
+        servedByNew = servedByNew || id == newId;
+        ::close(fd);
+        ++probes;
+    }
+
+    // 交接出去的空闲连接由新进程继续回显
+    id = echo(idleFd, "again\n");
+    CHECK(id == newId);
+
+    // 旧进程要等 busy 连接的数据发完才能退出
+    int status = 0;
+    bool oldExited = exited(oldPid, &status);
+    CHECK(!oldExited);
+    while ((n = ::read(busyFd, buf, sizeof buf)) > 0)
+    {
+        received += static_cast<size_t>(n);
+    }
+    CHECK(n == 0); // 发完后旧进程关闭写端
+    CHECK(received == kBigReplySize);
+    ::close(busyFd);
+
+    for (int i = 0; i < 500 && !oldExited; ++i)
+    {
+        oldExited = exited(oldPid, &status);
+        if (!oldExited)
+        {
+            usleep(10 * 1000);
+        }
+    }
+    CHECK(oldExited && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // 旧进程退出之后新进程照常服务
+    id = echo(idleFd, "still here\n");
+    CHECK(id == newId);
+    ::close(idleFd);
+
+    ::kill(newPid, SIGKILL);
+    ::waitpid(newPid, &status, 0);
+    ::unlink(path.c_str());
+    printf("hot restart ok: %d probe connections (%d served by the old process), old process drained and exited\n",
+           probes, servedByOld);
+    return 0;
+}
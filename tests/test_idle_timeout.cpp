@@ -0,0 +1,87 @@
+// tests/test_idle_timeout.cpp
+// 验证 TcpServer::setIdleTimeout：不说话的连接会被踢掉，持续收发的连接保持存活
+
+#include "net/TcpServer.h"
+#include "net/TcpConnection.h"
+#include "net/EventLoop.h"
+#include "net/InetAddress.h"
+#include "net/Buffer.h"
+#include "base/Logger.h"
+#include "base/Thread.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+const uint16_t kPort = 9982;
+
+int connectToServer()
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(kPort);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if (::connect(fd, (sockaddr*)&addr, sizeof addr) < 0)
+    {
+        LOG_FATAL << "connect failed";
+    }
+    return fd;
+}
+
+int main()
+{
+    EventLoop loop;
+    InetAddress addr(kPort);
+    TcpServer server(&loop, addr, "IdleServer");
+    server.setThreadNum(2);
+    server.setIdleTimeout(2);
+    server.setConnectionCallback([](const TcpConnectionPtr& conn) {
+        LOG_INFO << conn->name() << (conn->connected() ? " UP" : " DOWN");
+    });
+    server.setMessageCallback([](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        conn->send(buf->retrieveAllAsString());
+    });
+    server.start();
+
+    std::atomic<bool> idleClosed(false);
+    std::atomic<bool> activeAlive(false);
+
+    Thread client([&]() {
+        int idleFd = connectToServer();
+        int activeFd = connectToServer();
+
+        // 活跃连接每 500ms 发一次，持续 4 秒，超过空闲时间但从未空闲
+        char buf[16];
+        bool alive = true;
+        for (int i = 0; i < 8; ++i)
+        {
+            usleep(500 * 1000);
+            if (::write(activeFd, "ping", 4) != 4 || ::read(activeFd, buf, sizeof buf) <= 0)
+            {
+                alive = false;
+            }
+        }
+        activeAlive = alive;
+
+        // 空闲连接此时早已超时，应当读到 EOF
+        idleClosed = (::read(idleFd, buf, sizeof buf) == 0);
+
+        ::close(idleFd);
+        ::close(activeFd);
+        loop.quit();
+    }, "IdleClient");
+    client.start();
+
+    loop.loop();
+    client.join();
+
+    LOG_INFO << "idle connection closed: " << idleClosed << ", active connection alive: " << activeAlive;
+    assert(idleClosed);
+    assert(activeAlive);
+    return 0;
+}
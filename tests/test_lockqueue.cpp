@@ -1,61 +1,104 @@
-// examples/test_lockqueue.cpp
+// tests/test_lockqueue.cpp
+// LockQueue 与 MpmcQueue 的吞吐和延迟对比 (同时检查每个元素恰好被取走一次)：
+//   P 个生产者各 Push N 个带时间戳的元素，C 个消费者 Pop 直到队列关闭；
+//   吞吐 = 总元素数 / 总耗时，延迟 = Pop 出来的时刻 - Push 之前的时刻。
+// 两种队列的容量都是 kCapacity，满时生产者阻塞。
+// 用法: test_lockqueue [itemsPerProducer]，默认 100000
 
 #include "base/LockQueue.h"
-#include <iostream>
+#include "base/MpmcQueue.h"
+#include "base/MonoTime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
 #include <thread>
-#include <string>
-#include <chrono>
-#include <optional> // 确保包含了 optional 头文件
+#include <vector>
+
+namespace
+{
+
+const size_t kCapacity = 1024;
+
+struct Config
+{
+    int producers;
+    int consumers;
+};
 
-// 全局队列实例 (保持不变)
-LockQueue<int> g_queue;
-// 全局互斥锁，保护 cout (保持不变)
-std::mutex g_cout_mutex;
+const Config kConfigs[] = {{1, 1}, {1, 4}, {4, 1}, {4, 4}, {8, 8}};
 
-// 生产者函数 (保持不变)
-void producer()
+template<typename Queue>
+void runOnce(const char* name, const Config& config, int itemsPerProducer)
 {
-    for (int i = 0; i < 10; ++i)
+    Queue queue(kCapacity);
+    std::vector<std::vector<int64_t>> latencies(config.consumers);
+    std::atomic<long> consumed(0);
+
+    MonoTime start = MonoTime::now();
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < config.consumers; ++c)
     {
-        g_queue.Push(i);
-        {
-            std::lock_guard<std::mutex> lock(g_cout_mutex);
-            std::cout << "Producer pushed: " << i << std::endl;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100)); 
+        latencies[c].reserve(static_cast<size_t>(itemsPerProducer) * config.producers / config.consumers + 1);
+        consumers.emplace_back([&queue, &latencies, &consumed, c]() {
+            std::vector<int64_t>& mine = latencies[c];
+            while (auto item = queue.Pop())
+            {
+                mine.push_back(MonoTime::now().nanoSeconds() - *item);
+            }
+            consumed += static_cast<long>(mine.size());
+        });
     }
-}
 
-// 【核心修正】更新消费者函数
-void consumer()
-{
-    for (int i = 0; i < 10; ++i)
+    std::vector<std::thread> producers;
+    for (int p = 0; p < config.producers; ++p)
     {
-        // 1. Pop() 现在返回一个 optional 对象
-        std::optional<int> data_opt = g_queue.Pop();
-
-        // 2. 检查 optional 是否真的包含一个值
-        if (data_opt.has_value())
-        {
-            // 3. 如果有值，通过 .value() 方法取出它
-            int data = data_opt.value();
+        producers.emplace_back([&queue, itemsPerProducer]() {
+            for (int i = 0; i < itemsPerProducer; ++i)
             {
-                std::lock_guard<std::mutex> lock(g_cout_mutex);
-                std::cout << "                Consumer popped: " << data << std::endl;
+                queue.Push(MonoTime::now().nanoSeconds());
             }
-        }
-        // 在这个简单的测试中，我们不处理队列关闭的情况，所以可以省略 else
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    queue.Shutdown(); // 消费者取完剩下的元素后退出
+    for (auto& consumer : consumers)
+    {
+        consumer.join();
+    }
+    MonoTime end = MonoTime::now();
+
+    long total = static_cast<long>(itemsPerProducer) * config.producers;
+    assert(consumed.load() == total);
+
+    std::vector<int64_t> all;
+    all.reserve(total);
+    for (const auto& part : latencies)
+    {
+        all.insert(all.end(), part.begin(), part.end());
     }
+    std::sort(all.begin(), all.end());
+    double seconds = static_cast<double>(end.nanoSeconds() - start.nanoSeconds()) / 1e9;
+    printf("%-9s P=%d C=%d %11.0f items/s   latency p50 %8.1f us  p99 %9.1f us\n",
+           name, config.producers, config.consumers, static_cast<double>(total) / seconds,
+           static_cast<double>(all[all.size() / 2]) / 1000.0,
+           static_cast<double>(all[all.size() * 99 / 100]) / 1000.0);
 }
 
-// main 函数 (保持不变)
-int main()
-{
-    std::thread t1(producer);
-    std::thread t2(consumer);
+} // namespace
 
-    t1.join();
-    t2.join();
-    
+int main(int argc, char* argv[])
+{
+    int itemsPerProducer = argc > 1 ? atoi(argv[1]) : 100000;
+    for (const Config& config : kConfigs)
+    {
+        runOnce<LockQueue<int64_t>>("LockQueue", config, itemsPerProducer);
+        runOnce<MpmcQueue<int64_t>>("MpmcQueue", config, itemsPerProducer);
+    }
     return 0;
-}
\ No newline at end of file
+}
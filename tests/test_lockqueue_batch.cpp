@@ -0,0 +1,135 @@
+// tests/test_lockqueue_batch.cpp
+// 验证 LockQueue 的移动语义、非阻塞和批量接口：
+// - 只能移动的元素 (unique_ptr) 可以 Push / TryPush / Pop / TryPop / PopBatch
+// - TryPush 在满时返回 false 且不动右值参数
+// - PopBatch 最多取 n 个，PopAll 全部取走；腾出空位后阻塞的 Push 继续
+// - 多生产者 + PopAll 消费者：每个元素恰好收到一次
+// - Shutdown 之后 PopAll 返回 false
+// 移动语义和多生产者两项同样用 MpmcQueue 跑一遍 (接口相同)
+
+#include "base/LockQueue.h"
+#include "base/MpmcQueue.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+template<typename Queue>
+void testMoveOnly()
+{
+    Queue queue(2);
+    queue.Push(std::make_unique<int>(1));
+    bool accepted = queue.TryPush(std::make_unique<int>(2));
+    CHECK(accepted);
+
+    std::unique_ptr<int> rejected = std::make_unique<int>(3);
+    accepted = queue.TryPush(std::move(rejected));
+    CHECK(!accepted);
+    CHECK(rejected && *rejected == 3); // 失败时没有被移走
+
+    auto first = queue.Pop();
+    CHECK(first && **first == 1);
+    auto second = queue.TryPop();
+    CHECK(second && **second == 2);
+    auto third = queue.TryPop();
+    CHECK(!third);
+}
+
+void testBatch()
+{
+    LockQueue<int> queue(10);
+    for (int i = 0; i < 10; ++i)
+    {
+        queue.Push(i);
+    }
+
+    // 队列满，生产者阻塞，直到批量取走后才放入
+    std::atomic<bool> pushed(false);
+    std::thread producer([&]() {
+        queue.Push(10);
+        pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(!pushed.load());
+
+    std::vector<int> out;
+    bool popped = queue.PopBatch(out, 4);
+    CHECK(popped);
+    CHECK(out.size() == 4);
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(out[i] == i);
+    }
+    producer.join();
+    CHECK(pushed.load());
+
+    // 追加到已有内容之后
+    popped = queue.PopAll(out);
+    CHECK(popped);
+    CHECK(out.size() == 11);
+    for (int i = 0; i < 11; ++i)
+    {
+        CHECK(out[i] == i);
+    }
+
+    queue.Shutdown();
+    out.clear();
+    popped = queue.PopAll(out);
+    CHECK(!popped);
+    CHECK(out.empty());
+}
+
+template<typename Queue>
+void testConcurrent()
+{
+    const int kProducers = 4;
+    const int kPerProducer = 50000;
+    Queue queue(1024);
+    std::vector<int> seen(kProducers * kPerProducer, 0);
+
+    std::thread consumer([&]() {
+        std::vector<int> batch;
+        while (queue.PopAll(batch))
+        {
+            for (int value : batch)
+            {
+                seen[value]++;
+            }
+            batch.clear();
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < kPerProducer; ++i)
+            {
+                queue.Push(p * kPerProducer + i);
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    queue.Shutdown(); // 关闭后仍会把剩下的取完
+    consumer.join();
+
+    for (int count : seen)
+    {
+        CHECK(count == 1);
+    }
+}
+
+int main()
+{
+    testMoveOnly<LockQueue<std::unique_ptr<int>>>();
+    testMoveOnly<MpmcQueue<std::unique_ptr<int>>>();
+    testBatch();
+    testConcurrent<LockQueue<int>>();
+    testConcurrent<MpmcQueue<int>>();
+    return 0;
+}
@@ -0,0 +1,188 @@
+// tests/test_log_file.cpp
+// 验证 LogFile 的滚动：按大小滚动时每个文件不超过 rollSize (加上最后一次写入)，按时间滚动时跨周期换文件；
+// 再经 AsyncLogging 多线程写入滚动文件，所有文件按名字顺序拼起来一条不少、顺序不乱
+
+#include "base/AsyncLogging.h"
+#include "base/LogFile.h"
+#include "base/Logger.h"
+#include "base/Thread.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+std::vector<std::string> listFiles(const std::string& dir)
+{
+    std::vector<std::string> files;
+    DIR* d = ::opendir(dir.c_str());
+    CHECK(d != nullptr);
+    while (struct dirent* entry = ::readdir(d))
+    {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..")
+        {
+            files.push_back(dir + "/" + name);
+        }
+    }
+    ::closedir(d);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+off_t fileSize(const std::string& path)
+{
+    struct stat st;
+    int ret = ::stat(path.c_str(), &st);
+    CHECK(ret == 0);
+    return st.st_size;
+}
+
+void removeAll(const std::string& dir)
+{
+    for (const std::string& file : listFiles(dir))
+    {
+        ::unlink(file.c_str());
+    }
+    ::rmdir(dir.c_str());
+}
+
+std::string makeTempDir()
+{
+    char dir[] = "/tmp/test_log_file_XXXXXX";
+    char* created = ::mkdtemp(dir);
+    CHECK(created != nullptr);
+    return dir;
+}
+
+void testRollBySize()
+{
+    std::string dir = makeTempDir();
+    LogFile::Options options;
+    options.rollSize = 64 * 1024;
+    options.rollInterval = 0;
+    options.fsyncInterval = 1;
+    options.preallocate = true;
+
+    const std::string line(100, 'x');
+    const int kLines = 5000; // 约 500KB，应滚动出 8 个文件左右
+    {
+        LogFile file(dir + "/size", options);
+        for (int i = 0; i < kLines; ++i)
+        {
+            file.append(line.data(), line.size());
+            file.append("\n", 1);
+        }
+        file.flush();
+    }
+
+    std::vector<std::string> files = listFiles(dir);
+    CHECK(files.size() >= 7);
+    off_t total = 0;
+    for (const std::string& file : files)
+    {
+        off_t size = fileSize(file);
+        // 预分配的空间在关闭时截掉，文件大小只是实际内容
+        CHECK(size <= options.rollSize + static_cast<off_t>(line.size()));
+        total += size;
+    }
+    CHECK(total == static_cast<off_t>(kLines * (line.size() + 1)));
+    removeAll(dir);
+}
+
+void testRollByTime()
+{
+    std::string dir = makeTempDir();
+    LogFile::Options options;
+    options.rollSize = 0;
+    options.rollInterval = 1;
+    {
+        LogFile file(dir + "/time", options);
+        std::string first = file.filename();
+        file.append("first\n", 6);
+        ::usleep(1100 * 1000);
+        // 没有新日志时也会换文件
+        file.rollIfNeeded(::time(nullptr));
+        CHECK(file.filename() != first);
+        file.append("second\n", 7);
+    }
+    std::vector<std::string> files = listFiles(dir);
+    CHECK(files.size() == 2);
+    CHECK(fileSize(files[0]) == 6 && fileSize(files[1]) == 7);
+    removeAll(dir);
+}
+
+void testAsyncRolling()
+{
+    const int kThreads = 4;
+    const int kMessagesPerThread = 50000;
+
+    std::string dir = makeTempDir();
+    LogFile::Options options;
+    options.rollSize = 1024 * 1024;
+    options.preallocate = true;
+    AsyncLogging asyncLog(dir + "/async", options, 1);
+    asyncLog.start();
+    Logger::getInstance().setOutput(
+        [&asyncLog](const char* msg, size_t len) { asyncLog.append(msg, len); },
+        [&asyncLog]() { asyncLog.stop(); });
+
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back(new Thread([t]() {
+            for (int i = 0; i < kMessagesPerThread; ++i)
+            {
+                LOG_INFO << "log-file-test thread=" << t << " seq=" << i;
+            }
+        }, "LogFileProducer"));
+        threads.back()->start();
+    }
+    for (auto& thread : threads)
+    {
+        thread->join();
+    }
+    asyncLog.stop();
+    Logger::getInstance().setOutput(nullptr);
+
+    std::vector<std::string> files = listFiles(dir);
+    CHECK(files.size() > 1);
+    std::vector<int> next(kThreads, 0);
+    for (const std::string& file : files)
+    {
+        std::ifstream in(file);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            size_t pos = line.find("log-file-test thread=");
+            CHECK(pos != std::string::npos);
+            int t = -1, seq = -1;
+            int matched = sscanf(line.c_str() + pos, "log-file-test thread=%d seq=%d", &t, &seq);
+            CHECK(matched == 2 && t >= 0 && t < kThreads);
+            CHECK(seq == next[t]);
+            ++next[t];
+        }
+    }
+    for (int t = 0; t < kThreads; ++t)
+    {
+        CHECK(next[t] == kMessagesPerThread);
+    }
+    LOG_INFO << "async rolling wrote " << files.size() << " files";
+    removeAll(dir);
+}
+
+int main()
+{
+    testRollBySize();
+    testRollByTime();
+    testAsyncRolling();
+    LOG_INFO << "log file rotation ok";
+    return 0;
+}
@@ -0,0 +1,65 @@
+// tests/test_log_module_level.cpp
+// 验证级别判断：全局级别、模块级覆盖 (模块名为文件名去掉扩展名) 与清除覆盖
+
+#include "base/Logger.h"
+#include "TestCheck.h"
+
+#include <string>
+
+int g_lines = 0;
+
+void count(const char*, size_t)
+{
+    ++g_lines;
+}
+
+// 依次打 DEBUG / INFO / ERROR 各一条，返回实际输出的条数
+int logAll()
+{
+    g_lines = 0;
+    LOG_DEBUG << "debug";
+    LOG_INFO << "info";
+    LOG_ERROR << "error";
+    return g_lines;
+}
+
+int main()
+{
+    Logger& logger = Logger::getInstance();
+    logger.setOutput(count);
+    // Release 构建默认在编译期去掉 LOG_DEBUG
+    const int debugCompiled = MYMUDUO_MIN_LOG_LEVEL <= DEBUG ? 1 : 0;
+
+    logger.setLogLevel(INFO);
+    CHECK(logAll() == 2);
+    logger.setLogLevel(ERROR);
+    CHECK(logAll() == 1);
+    logger.setLogLevel(DEBUG);
+    CHECK(logAll() == 2 + debugCompiled);
+
+    // 覆盖别的模块不影响本文件，但会把阈值降低，让本文件走模块表检查
+    logger.setLogLevel(ERROR);
+    logger.setModuleLevel("EventLoop", DEBUG);
+    CHECK(g_logModuleOverrides.load());
+    CHECK(logAll() == 1);
+
+    // 覆盖本模块：不受全局级别影响
+    logger.setModuleLevel("test_log_module_level", INFO);
+    CHECK(logAll() == 2);
+    logger.setModuleLevel("test_log_module_level", DEBUG);
+    CHECK(logAll() == 2 + debugCompiled);
+    logger.setModuleLevel("test_log_module_level", FATAL);
+    CHECK(logAll() == 0);
+
+    // 清除后跟随全局级别
+    logger.clearModuleLevel("test_log_module_level");
+    logger.clearModuleLevel("EventLoop");
+    CHECK(!g_logModuleOverrides.load());
+    CHECK(g_logThreshold.load() == ERROR);
+    CHECK(logAll() == 1);
+
+    logger.setLogLevel(INFO);
+    logger.setOutput(nullptr);
+    LOG_INFO << "log level checks ok";
+    return 0;
+}
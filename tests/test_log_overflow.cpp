@@ -0,0 +1,148 @@
+// tests/test_log_overflow.cpp
+// 验证日志队列满时的策略和限流宏：
+// - stdout 换成一个暂时没人读的管道，写线程很快阻塞，队列随之写满；
+//   每种策略下 "实际输出的条数 + droppedMessages() 的增量" 等于打出的条数
+// - LOG_EVERY_N / LOG_RATE_LIMITED 只放行预期的条数
+
+#include "base/Logger.h"
+#include "TestCheck.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+// 每条约 70 字节，远超管道缓冲区 (64KB) 加队列容量；阻塞策略每丢一条要等满超时，少打一些
+const int kMessages = 20000;
+const int kBlockMessages = 2000;
+const int kRingBlockMessages = 6000; // 线程环 256KB + 管道 64KB 约 4500 条
+
+int g_lines = 0;
+
+void count(const char*, size_t)
+{
+    ++g_lines;
+}
+
+// 读管道直到看到结束标记，返回测试消息的行数
+int readUntilEnd(int fd)
+{
+    std::string pending;
+    char buf[65536];
+    int lines = 0;
+    while (true)
+    {
+        ssize_t n = ::read(fd, buf, sizeof buf);
+        CHECK(n > 0);
+        pending.append(buf, n);
+        size_t pos;
+        while ((pos = pending.find('\n')) != std::string::npos)
+        {
+            std::string line = pending.substr(0, pos);
+            pending.erase(0, pos + 1);
+            if (line.find("overflow-test END") != std::string::npos)
+            {
+                return lines;
+            }
+            if (line.find("overflow-test seq=") != std::string::npos)
+            {
+                ++lines;
+            }
+        }
+    }
+}
+
+void runCase(const char* name, Logger::QueueMode mode, Logger::OverflowPolicy policy, int messages)
+{
+    Logger& logger = Logger::getInstance();
+    int fds[2];
+    int ret = ::pipe(fds);
+    CHECK(ret == 0);
+    fflush(stdout);
+    int savedStdout = ::dup(STDOUT_FILENO);
+    ::dup2(fds[1], STDOUT_FILENO);
+
+    logger.setQueueCapacity(100); // MpmcQueue 在第一次切换时按这个容量创建
+    logger.setQueueMode(mode);
+    logger.setOverflowPolicy(policy, 1);
+    uint64_t droppedBefore = logger.droppedMessages();
+    for (int i = 0; i < messages; ++i)
+    {
+        LOG_INFO << "overflow-test seq=" << i << " payload=0123456789abcdef";
+    }
+    uint64_t dropped = logger.droppedMessages() - droppedBefore;
+
+    // 开始读管道，结束标记用阻塞策略发出，保证不丢
+    int lines = 0;
+    std::thread reader([&lines, fds]() { lines = readUntilEnd(fds[0]); });
+    logger.setOverflowPolicy(Logger::OverflowPolicy::kBlock);
+    LOG_INFO << "overflow-test END";
+    logger.flush();
+    reader.join();
+
+    fflush(stdout);
+    ::dup2(savedStdout, STDOUT_FILENO);
+    ::close(savedStdout);
+    ::close(fds[0]);
+    ::close(fds[1]);
+
+    fprintf(stderr, "%-24s written %5d dropped %5llu\n", name, lines, static_cast<unsigned long long>(dropped));
+    CHECK(dropped > 0);
+    CHECK(lines + static_cast<int>(dropped) == messages);
+}
+
+void testRateLimit()
+{
+    Logger& logger = Logger::getInstance();
+    logger.setOutput(count);
+
+    g_lines = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        LOG_EVERY_N(INFO, 100) << "every-n " << i;
+    }
+    CHECK(g_lines == 10);
+
+    g_lines = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        LOG_RATE_LIMITED(INFO, 5) << "rate-limited " << i;
+    }
+    CHECK(g_lines == 5);
+    ::usleep(1100 * 1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        LOG_RATE_LIMITED(INFO, 5) << "rate-limited " << i;
+    }
+    CHECK(g_lines == 10);
+
+    // 被级别过滤掉的语句不计数
+    logger.setLogLevel(ERROR);
+    for (int i = 0; i < 50; ++i)
+    {
+        LOG_EVERY_N(INFO, 100) << "filtered " << i;
+    }
+    logger.setLogLevel(INFO);
+    LOG_EVERY_N(INFO, 100) << "every-n after filtered";
+    CHECK(g_lines == 11);
+
+    logger.setOutput(nullptr);
+}
+
+int main()
+{
+    testRateLimit();
+
+    runCase("lockqueue drop-newest", Logger::QueueMode::kLockQueue, Logger::OverflowPolicy::kDropNewest, kMessages);
+    runCase("lockqueue drop-oldest", Logger::QueueMode::kLockQueue, Logger::OverflowPolicy::kDropOldest, kMessages);
+    runCase("lockqueue block(1ms)", Logger::QueueMode::kLockQueue, Logger::OverflowPolicy::kBlock, kBlockMessages);
+    runCase("mpmc drop-newest", Logger::QueueMode::kMpmcQueue, Logger::OverflowPolicy::kDropNewest, kMessages);
+    runCase("mpmc drop-oldest", Logger::QueueMode::kMpmcQueue, Logger::OverflowPolicy::kDropOldest, kMessages);
+    runCase("mpmc block(1ms)", Logger::QueueMode::kMpmcQueue, Logger::OverflowPolicy::kBlock, kBlockMessages);
+    runCase("rings drop-newest", Logger::QueueMode::kThreadRings, Logger::OverflowPolicy::kDropNewest, kMessages);
+    runCase("rings block(1ms)", Logger::QueueMode::kThreadRings, Logger::OverflowPolicy::kBlock, kRingBlockMessages);
+
+    Logger::getInstance().setOverflowPolicy(Logger::OverflowPolicy::kBlock);
+    LOG_INFO << "log overflow policies ok";
+    return 0;
+}
@@ -0,0 +1,127 @@
+// tests/test_log_stream.cpp
+// 验证定长缓冲区 LogStream 的格式化结果与 ostringstream 一致 (包括只提供了 ostream 插入运算符的用户类型)，
+// 并且超长字符串被截断到缓冲区末尾而不是越界或整段丢弃
+
+#include "base/Logger.h"
+
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// 取出消息正文 (去掉时间、级别、文件名前缀和结尾的换行)
+std::string g_last;
+
+void capture(const char* msg, size_t len)
+{
+    g_last.assign(msg, len);
+}
+
+// 没有 LogStream 重载、只能写进 ostream 的类型
+struct Point
+{
+    int x;
+    int y;
+};
+
+std::ostream& operator<<(std::ostream& os, const Point& p)
+{
+    return os << '(' << p.x << ", " << p.y << ')';
+}
+
+enum class Color
+{
+    kRed,
+    kGreen,
+};
+
+std::ostream& operator<<(std::ostream& os, Color c)
+{
+    return os << (c == Color::kRed ? "red" : "green");
+}
+
+std::string body()
+{
+    // 前缀以 "文件名:行号 " 结尾
+    size_t pos = g_last.find(".cpp:");
+    pos = g_last.find(' ', pos);
+    return g_last.substr(pos + 1, g_last.size() - pos - 2);
+}
+
+template<typename T>
+void expectSame(const T& value)
+{
+    std::ostringstream expected;
+    expected << value;
+    LOG_INFO << value;
+    assert(body() == expected.str());
+}
+
+int main()
+{
+    Logger::getInstance().setOutput(capture);
+
+    expectSame(0);
+    expectSame(-1);
+    expectSame(INT_MIN);
+    expectSame(INT_MAX);
+    expectSame(static_cast<short>(-123));
+    expectSame(static_cast<unsigned short>(65535));
+    expectSame(UINT_MAX);
+    expectSame(LONG_MIN);
+    expectSame(LLONG_MIN);
+    expectSame(ULLONG_MAX);
+    expectSame(static_cast<size_t>(123456789));
+    expectSame('x');
+    expectSame(std::string("hello"));
+    expectSame("world");
+
+    expectSame(0.1);
+    expectSame(-2.25);
+    expectSame(1e100);
+    expectSame(123456789.0);
+    expectSame(3.14f);
+
+    expectSame(Point{3, -4});
+    expectSame(Color::kGreen);
+    LOG_INFO << "at " << Point{1, 2} << ' ' << Color::kRed << ' ' << 7;
+    assert(body() == "at (1, 2) red 7");
+
+    LOG_INFO << static_cast<const void*>(nullptr) << ' ' << reinterpret_cast<const void*>(0xdeadbeef);
+    assert(body() == "0x0 0xdeadbeef");
+
+    std::string_view view("abcdef");
+    LOG_INFO << view.substr(1, 3) << static_cast<const char*>(nullptr) << true;
+    assert(body() == "bcd(null)1");
+
+    // 超出缓冲区的部分被截断：字符串写到缓冲区末尾，之后放不下的数字丢弃，消息仍以换行结尾
+    std::string huge(2 * kSmallBuffer, 'z');
+    LOG_INFO << huge << 42;
+    assert(static_cast<int>(g_last.size()) == kSmallBuffer - 1);
+    assert(g_last.back() == '\n');
+    std::string truncated = body();
+    assert(!truncated.empty() && truncated.find_first_not_of('z') == std::string::npos);
+
+    // 前缀 "YYYY-MM-DD HH:MM:SS.uuuuuu [INFO] test_log_stream.cpp:行号 "：日期时间与 Timestamp 一致，
+    // 文件名不带目录
+    std::string before = Timestamp::now().toString();
+    LOG_INFO << "prefix";
+    std::string after = Timestamp::now().toString();
+    std::string dateTime = g_last.substr(0, 19);
+    assert(dateTime == before || dateTime == after);
+    assert(g_last[19] == '.' && g_last[26] == ' ');
+    for (int i = 20; i < 26; ++i)
+    {
+        assert(g_last[i] >= '0' && g_last[i] <= '9');
+    }
+    const std::string expectedSource = "[INFO] test_log_stream.cpp:";
+    assert(g_last.compare(27, expectedSource.size(), expectedSource) == 0);
+    assert(body() == "prefix");
+
+    Logger::getInstance().setOutput(nullptr);
+    LOG_INFO << "log stream formatting ok";
+    return 0;
+}
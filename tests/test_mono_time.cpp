@@ -0,0 +1,56 @@
+// tests/test_mono_time.cpp
+// 验证 MonoTime：读数单调不减；启用 rdtsc 快速路径后与 CLOCK_MONOTONIC 保持一致
+
+#include "base/MonoTime.h"
+#include "base/Logger.h"
+
+#include <cassert>
+#include <ctime>
+#include <unistd.h>
+
+const int kReads = 1000000;
+const int64_t kMaxSkewUs = 1000;
+
+int64_t clockMonotonicUs()
+{
+    struct timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+// 连续读 kReads 次，返回每次读取的平均纳秒数
+double checkMonotonic()
+{
+    MonoTime start = MonoTime::now();
+    MonoTime last = start;
+    for (int i = 0; i < kReads; ++i)
+    {
+        MonoTime now = MonoTime::now();
+        assert(!(now < last));
+        last = now;
+    }
+    return static_cast<double>(last.nanoSeconds() - start.nanoSeconds()) / kReads;
+}
+
+int main()
+{
+    assert(MonoTime::now().valid());
+    double clockNs = checkMonotonic();
+    LOG_INFO << "clock_gettime path: " << clockNs << " ns/read";
+
+    if (!MonoTime::enableTsc())
+    {
+        LOG_INFO << "invariant TSC not available, skipping rdtsc checks";
+        return 0;
+    }
+    assert(MonoTime::tscEnabled());
+    double tscNs = checkMonotonic();
+    LOG_INFO << "rdtsc path: " << tscNs << " ns/read";
+
+    // 运行一段时间后，两条路径仍然在同一时间轴上
+    usleep(200 * 1000);
+    int64_t skewUs = MonoTime::now().microSeconds() - clockMonotonicUs();
+    LOG_INFO << "rdtsc vs CLOCK_MONOTONIC skew after 200ms: " << skewUs << " us";
+    assert(skewUs < kMaxSkewUs && skewUs > -kMaxSkewUs);
+    return 0;
+}
@@ -0,0 +1,136 @@
+// tests/test_priority_threadpool.cpp
+// 验证优先级 / 截止时间调度：
+// - PriorityTaskQueue：高优先级先出；同一优先级内截止时间早的先出，没有截止时间的按放入顺序排在最后
+// - ThreadPool(kPriorityQueue)：唯一的 worker 被占住时排队的任务，按 kHigh -> kNormal -> kLow 的顺序执行
+// - 过了截止时间的任务不执行，改为调用 onExpired，并计入 stats().expiredTasks
+// - 默认的 FIFO 队列同样检查截止时间
+
+#include "base/ThreadPool.h"
+#include "base/PriorityTaskQueue.h"
+#include "base/MonoTime.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void testQueueOrder()
+{
+    PriorityTaskQueue<int> queue(3);
+    const int64_t none = PriorityTaskQueue<int>::kNoDeadline;
+    queue.Push(1, 2, none);
+    queue.Push(2, 1, none);
+    queue.Push(3, 1, 300);
+    queue.Push(4, 1, 100);
+    queue.Push(5, 0, none);
+    queue.Push(6, 1, none);
+    queue.Push(7, 9, none); // 越界按最低优先级
+    CHECK(queue.Size() == 7);
+
+    std::vector<int> out;
+    bool popped = queue.PopBatch(out, 2);
+    CHECK(popped);
+    CHECK((out == std::vector<int>{5, 4}));
+    popped = queue.PopBatch(out, 10);
+    CHECK(popped);
+    CHECK((out == std::vector<int>{5, 4, 3, 2, 6, 1, 7}));
+    CHECK(queue.Size() == 0);
+
+    out.clear();
+    popped = queue.PopBatchFor(out, 1, std::chrono::milliseconds(10));
+    CHECK(!popped); // 超时
+    queue.Shutdown();
+    popped = queue.PopBatch(out, 1);
+    CHECK(!popped);
+}
+
+// 用一个任务占住唯一的 worker，等其它任务都入队之后再放开
+class Gate
+{
+public:
+    void block(ThreadPool& pool)
+    {
+        pool.addTask([this]() {
+            m_entered = true;
+            while (!m_open.load())
+            {
+                std::this_thread::yield();
+            }
+        });
+        while (!m_entered.load())
+        {
+            std::this_thread::yield();
+        }
+    }
+    void open() { m_open = true; }
+
+private:
+    std::atomic<bool> m_entered{false};
+    std::atomic<bool> m_open{false};
+};
+
+void testPoolPriority()
+{
+    ThreadPool pool(1, "Priority");
+    pool.setQueueType(ThreadPool::QueueType::kPriorityQueue);
+    pool.start();
+
+    Gate gate;
+    gate.block(pool);
+
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int id) {
+        return [&, id]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(id);
+        };
+    };
+    MonoTime now = MonoTime::now();
+    pool.addTask(record(1), ThreadPool::Priority::kLow);
+    pool.addTask(record(2));
+    pool.addTask(record(3), ThreadPool::Priority::kHigh, addTime(now, 20.0));
+    pool.addTask(record(4), ThreadPool::Priority::kHigh, addTime(now, 10.0));
+    pool.addTask(record(5), ThreadPool::Priority::kHigh);
+
+    // 截止时间在 worker 放开之前就过了
+    std::atomic<int> expired(0);
+    pool.addTask(record(6), ThreadPool::Priority::kHigh, addTime(now, 0.001), [&expired]() { ++expired; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    gate.open();
+    pool.shutdown();
+    CHECK((order == std::vector<int>{4, 3, 5, 2, 1}));
+    CHECK(expired.load() == 1);
+    CHECK(pool.stats().expiredTasks == 1);
+}
+
+void testFifoDeadline()
+{
+    ThreadPool pool(1, "Fifo");
+    pool.start();
+
+    Gate gate;
+    gate.block(pool);
+
+    std::atomic<int> ran(0);
+    std::atomic<int> expired(0);
+    pool.addTask([&ran]() { ++ran; }, ThreadPool::Priority::kLow, addTime(MonoTime::now(), 0.001),
+                 [&expired]() { ++expired; });
+    pool.addTask([&ran]() { ++ran; }, ThreadPool::Priority::kLow, addTime(MonoTime::now(), 60.0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    gate.open();
+    pool.shutdown();
+    CHECK(ran.load() == 1);
+    CHECK(expired.load() == 1);
+}
+
+int main()
+{
+    testQueueOrder();
+    testPoolPriority();
+    testFifoDeadline();
+    return 0;
+}
@@ -0,0 +1,206 @@
+// tests/test_strand.cpp
+// 验证 Strand 串行执行器：
+// - 同一个 Strand 上的任务按提交顺序执行、从不重叠 (多个 Strand 同时压测)
+// - 不同 Strand 的任务并行：4 个 Strand 各 5 个 10ms 的任务，4 个 worker 上约 50ms 完成
+// - 按连接卸载：服务端把每行请求交给 conn->strand(&pool)，处理耗时参差不齐，
+//   结果经 then 回到连接的 loop 发送，客户端收到的回复顺序与请求顺序一致
+// - 线程池关闭后：任务被丢弃，submit 的句柄以 abandoned 结束，之后的 post 同样被丢弃而不是积压
+
+#include "base/Strand.h"
+#include "base/ThreadPool.h"
+#include "base/Thread.h"
+#include "base/MonoTime.h"
+#include "base/Logger.h"
+#include "net/TcpServer.h"
+#include "net/TcpConnection.h"
+#include "net/EventLoop.h"
+#include "net/InetAddress.h"
+#include "net/Buffer.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+struct Checker
+{
+    std::atomic<int> inside{0};
+    int next = 0; // 只在 Strand 的任务里读写，不加锁
+};
+
+void testOrdering(ThreadPool& pool)
+{
+    const int kStrands = 16;
+    const int kPosters = 4;
+    const int kTasks = 5000;
+    std::vector<std::shared_ptr<Strand>> strands;
+    std::vector<Checker> checkers(kStrands);
+    for (int i = 0; i < kStrands; ++i)
+    {
+        strands.push_back(std::make_shared<Strand>(&pool));
+    }
+
+    std::atomic<int> done(0);
+    std::vector<std::thread> posters;
+    for (int p = 0; p < kPosters; ++p)
+    {
+        // 每个 Strand 只由一个线程提交，提交顺序就是期望的执行顺序
+        posters.emplace_back([&, p]() {
+            for (int i = 0; i < kTasks; ++i)
+            {
+                for (int s = p; s < kStrands; s += kPosters)
+                {
+                    Checker* checker = &checkers[s];
+                    strands[s]->post([checker, i, &done]() {
+                        int inside = checker->inside.fetch_add(1);
+                        CHECK(inside == 0);
+                        CHECK(checker->next == i);
+                        ++checker->next;
+                        checker->inside.fetch_sub(1);
+                        done.fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+            }
+        });
+    }
+    for (auto& poster : posters)
+    {
+        poster.join();
+    }
+    while (done.load() < kStrands * kTasks)
+    {
+        std::this_thread::yield();
+    }
+    for (Checker& checker : checkers)
+    {
+        CHECK(checker.next == kTasks);
+    }
+}
+
+void testParallel(ThreadPool& pool)
+{
+    const int kStrands = 4;
+    const int kTasks = 5;
+    std::vector<std::shared_ptr<Strand>> strands;
+    std::atomic<int> done(0);
+    MonoTime start = MonoTime::now();
+    for (int s = 0; s < kStrands; ++s)
+    {
+        strands.push_back(std::make_shared<Strand>(&pool));
+        for (int i = 0; i < kTasks; ++i)
+        {
+            strands[s]->post([&done]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                ++done;
+            });
+        }
+    }
+    while (done.load() < kStrands * kTasks)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    int64_t elapsedMs = microSecondsBetween(MonoTime::now(), start) / 1000;
+    LOG_INFO << "4 strands x 5 x 10ms finished in " << elapsedMs << "ms";
+    CHECK(elapsedMs < 150); // 串行需要 200ms
+}
+
+void testConnectionOffload(ThreadPool& pool)
+{
+    const int kRequests = 200;
+    EventLoop loop;
+    InetAddress addr(9986);
+    TcpServer server(&loop, addr, "StrandServer");
+    server.setConnectionCallback([](const TcpConnectionPtr&) {});
+    server.setMessageCallback([&pool](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        std::string data = buf->retrieveAllAsString();
+        size_t begin = 0;
+        size_t end;
+        while ((end = data.find('\n', begin)) != std::string::npos)
+        {
+            int n = std::stoi(data.substr(begin, end - begin));
+            begin = end + 1;
+            conn->strand(&pool)
+                ->submit([n]() {
+                    // 耗时参差不齐：若不串行，后面的请求会先完成
+                    std::this_thread::sleep_for(std::chrono::microseconds((n % 4) * 300));
+                    return std::to_string(n) + "\n";
+                })
+                .then(conn->getLoop(), [conn](std::string reply) {
+                    CHECK(conn->getLoop()->isInLoopThread());
+                    conn->send(std::move(reply));
+                });
+        }
+        // 不完整的一行放回去 (测试中每次 write 都是整行，这里只是保持协议正确)
+        buf->append(data.data() + begin, data.size() - begin);
+    });
+    server.start();
+
+    Thread client([&]() {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in serverAddr = *addr.getSockAddr();
+        if (::connect(fd, (sockaddr*)&serverAddr, sizeof serverAddr) < 0)
+        {
+            LOG_FATAL << "connect failed";
+        }
+        std::string requests;
+        for (int i = 0; i < kRequests; ++i)
+        {
+            requests += std::to_string(i) + "\n";
+        }
+        ssize_t written = ::write(fd, requests.data(), requests.size());
+        CHECK(written == static_cast<ssize_t>(requests.size()));
+
+        std::string replies;
+        char buf[4096];
+        while (replies != requests)
+        {
+            CHECK(replies.size() < requests.size() && requests.compare(0, replies.size(), replies) == 0);
+            ssize_t n = ::read(fd, buf, sizeof buf);
+            CHECK(n > 0);
+            replies.append(buf, n);
+        }
+        ::close(fd);
+        loop.queueInLoop([&loop]() { loop.quit(); });
+    }, "StrandClient");
+    client.start();
+    loop.runAfter(20.0, []() {
+        LOG_ERROR << "strand connection test timed out";
+        abort();
+    });
+    loop.loop();
+    client.join();
+}
+
+// 线程池已经关闭
+void testStoppedPool(ThreadPool& pool)
+{
+    auto strand = std::make_shared<Strand>(&pool);
+    auto captured = std::make_shared<int>(1);
+    TaskFuture<int> future = strand->submit([captured]() { return *captured; });
+    future.wait();
+    CHECK(future.abandoned());
+    strand->post([captured]() { abort(); });
+    TaskFuture<void> second = strand->submit([]() {});
+    second.wait();
+    CHECK(second.abandoned());
+    CHECK(captured.use_count() == 2); // 只剩 future 持有的那份
+}
+
+int main()
+{
+    ThreadPool pool(4, "Strand");
+    pool.start();
+    testOrdering(pool);
+    testParallel(pool);
+    testConnectionOffload(pool);
+    pool.shutdown();
+    testStoppedPool(pool);
+    LOG_INFO << "strand ok";
+    return 0;
+}
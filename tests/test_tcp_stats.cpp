@@ -0,0 +1,99 @@
+// tests/test_tcp_stats.cpp
+// 验证 TcpServer::enableStats：回显若干字节后，读写字节数和系统调用次数应当对得上；
+// 连接关闭时汇总值不会短暂变小 (连接移出连接表、IO 线程还没执行 connectDestroyed 的窗口里也一样)
+
+#include "net/TcpServer.h"
+#include "net/TcpConnection.h"
+#include "net/EventLoop.h"
+#include "net/InetAddress.h"
+#include "net/Buffer.h"
+#include "base/Logger.h"
+#include "base/Thread.h"
+
+#include <cassert>
+#include <cstring>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+const uint16_t kPort = 9983;
+const int kRounds = 100;
+const int kMessageSize = 64;
+
+int main()
+{
+    EventLoop loop;
+    InetAddress addr(kPort);
+    TcpServer server(&loop, addr, "StatsServer");
+    server.setThreadNum(2);
+    server.enableStats(true);
+    server.setConnectionCallback([&loop, &server](const TcpConnectionPtr& conn) {
+        if (!conn->connected())
+        {
+            LOG_INFO << conn->name() << " closed, " << conn->stats().toString();
+            // 拖住 IO 线程，connectDestroyed 要很久之后才轮到；
+            // 这期间 baseLoop 早已执行完 removeConnectionInLoop，汇总值仍应包含这个连接
+            conn->getLoop()->queueInLoop([]() { usleep(300 * 1000); });
+            loop.runAfter(0.1, [&server]() {
+                assert(server.totalStats().bytesIn == kRounds * kMessageSize);
+                assert(server.totalStats().bytesOut == kRounds * kMessageSize);
+            });
+        }
+    });
+    server.setMessageCallback([](const TcpConnectionPtr& conn, Buffer* buf, Timestamp) {
+        conn->send(buf->retrieveAllAsString());
+    });
+    server.start();
+
+    Thread client([&]() {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in serverAddr = *addr.getSockAddr();
+        if (::connect(fd, (sockaddr*)&serverAddr, sizeof serverAddr) < 0)
+        {
+            LOG_FATAL << "connect failed";
+        }
+
+        // ping-pong：每轮发一条，等收齐再发下一条
+        char msg[kMessageSize];
+        memset(msg, 'x', sizeof msg);
+        char buf[kMessageSize];
+        for (int i = 0; i < kRounds; ++i)
+        {
+            ::write(fd, msg, sizeof msg);
+            size_t got = 0;
+            while (got < sizeof buf)
+            {
+                ssize_t n = ::read(fd, buf + got, sizeof buf - got);
+                assert(n > 0);
+                got += n;
+            }
+        }
+
+        // 存活连接的统计在 baseLoop 中读取
+        loop.runInLoop([&]() {
+            TcpStats::Snapshot live = server.totalStats();
+            LOG_INFO << "live: " << live.toString();
+            assert(live.bytesIn == kRounds * kMessageSize);
+            assert(live.bytesOut == kRounds * kMessageSize);
+            assert(live.readCalls >= kRounds);
+            assert(live.writeCalls >= kRounds);
+        });
+
+        ::close(fd);
+        sleep(1);
+
+        // 关闭之后统计并入 loop 的累计值，总数不变
+        loop.runInLoop([&]() {
+            TcpStats::Snapshot closed = server.totalStats();
+            LOG_INFO << "after close: " << closed.toString();
+            assert(closed.bytesIn == kRounds * kMessageSize);
+            assert(closed.bytesOut == kRounds * kMessageSize);
+            loop.quit();
+        });
+    }, "StatsClient");
+    client.start();
+
+    loop.loop();
+    client.join();
+    return 0;
+}
@@ -0,0 +1,86 @@
+// tests/test_timer_heap.cpp
+// 验证 TimerQueue 的 4 叉堆和对象池：触发顺序、cancel、回调中自我取消、失效 TimerId 不会误伤复用的 Timer
+
+#include "net/EventLoop.h"
+#include "base/Logger.h"
+#include "base/Thread.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+
+const int kTimers = 2000;
+
+int main()
+{
+    EventLoop loop;
+
+    // 1. 乱序添加的定时器按到期时间触发 (用同一个基准时间，避免添加耗时影响顺序)；每隔 3 个取消一个
+    std::vector<int> fired;
+    std::vector<TimerId> ids;
+    std::vector<bool> canceled(kTimers, false);
+    srand(42);
+    std::vector<int> delayMs(kTimers);
+    MonoTime base = MonoTime::now();
+    for (int i = 0; i < kTimers; ++i)
+    {
+        delayMs[i] = 10 + rand() % 200;
+        ids.push_back(loop.runAt(addTime(base, delayMs[i] / 1000.0), [&fired, i]() { fired.push_back(i); }));
+    }
+    for (int i = 0; i < kTimers; i += 3)
+    {
+        loop.cancel(ids[i]);
+        canceled[i] = true;
+    }
+
+    // 2. 重复定时器在自己的回调中取消自己
+    int selfCancelCount = 0;
+    TimerId selfId;
+    selfId = loop.runEvery(0.01, [&]() {
+        if (++selfCancelCount == 3)
+        {
+            loop.cancel(selfId);
+        }
+    });
+
+    // 3. 其它线程添加的定时器同样生效
+    bool crossThreadFired = false;
+    Thread adder([&]() {
+        loop.runAfter(0.05, [&]() { crossThreadFired = true; });
+    }, "TimerAdder");
+    adder.start();
+    adder.join();
+
+    bool reusedFired = false;
+    loop.runAfter(0.4, [&]() {
+        // 一次性定时器都已归还对象池，用旧的 TimerId 取消不应影响复用它们的新定时器
+        loop.runAfter(0.01, [&]() {
+            reusedFired = true;
+            loop.quit();
+        });
+        for (const TimerId& id : ids)
+        {
+            loop.cancel(id);
+        }
+    });
+    // 兜底：复用的定时器被误取消时测试仍能结束
+    loop.runAfter(1.0, [&]() { loop.quit(); });
+    loop.loop();
+
+    size_t expected = 0;
+    for (int i = 0; i < kTimers; ++i)
+    {
+        if (!canceled[i]) ++expected;
+    }
+    assert(fired.size() == expected);
+    for (size_t i = 1; i < fired.size(); ++i)
+    {
+        assert(delayMs[fired[i - 1]] <= delayMs[fired[i]]);
+        assert(!canceled[fired[i]]);
+    }
+    assert(selfCancelCount == 3);
+    assert(crossThreadFired);
+    assert(reusedFired);
+    LOG_INFO << "timer heap: " << fired.size() << " fired in order, " << (kTimers - expected) << " canceled";
+    return 0;
+}
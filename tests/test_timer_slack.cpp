@@ -0,0 +1,62 @@
+// tests/test_timer_slack.cpp
+// 验证 slack 定时器：在 [到期时间, 到期时间 + slack] 窗口内触发，窗口重叠的定时器合并成少数几批
+
+#include "net/EventLoop.h"
+#include "base/Logger.h"
+#include "TestCheck.h"
+
+#include <set>
+#include <vector>
+
+const int kTimers = 100;
+const int kFirstMs = 20;
+const double kSlack = 0.05;
+const int64_t kToleranceUs = 5000; // 调度误差
+
+int main()
+{
+    EventLoop loop;
+    MonoTime base = MonoTime::now();
+
+    // 每隔 1ms 一个，窗口 50ms，相邻窗口大量重叠
+    std::vector<MonoTime> when(kTimers);
+    std::vector<MonoTime> firedAt(kTimers);
+    std::set<int64_t> batches; // 同一批定时器共享同一个 pollReturnTime
+    int fired = 0;
+    for (int i = 0; i < kTimers; ++i)
+    {
+        when[i] = addTime(base, (kFirstMs + i) / 1000.0);
+        loop.runAt(when[i], [&, i]() {
+            firedAt[i] = MonoTime::now();
+            batches.insert(loop.pollReturnTime().microSecondsSinceEpoch());
+            if (++fired == kTimers)
+            {
+                loop.quit();
+            }
+        }, kSlack);
+    }
+
+    // 精确定时器夹在中间，仍然准时触发
+    MonoTime preciseWhen = addTime(base, 0.03);
+    MonoTime preciseFiredAt;
+    loop.runAt(preciseWhen, [&]() { preciseFiredAt = MonoTime::now(); });
+
+    loop.runAfter(2.0, [&]() { loop.quit(); }); // 兜底
+    loop.loop();
+
+    CHECK(fired == kTimers);
+    const int64_t slackUs = static_cast<int64_t>(kSlack * Timestamp::kMicroSecondsPerSecond);
+    for (int i = 0; i < kTimers; ++i)
+    {
+        int64_t lateUs = microSecondsBetween(firedAt[i], when[i]);
+        CHECK(lateUs >= 0);
+        CHECK(lateUs <= slackUs + kToleranceUs);
+    }
+    int64_t preciseLateUs = microSecondsBetween(preciseFiredAt, preciseWhen);
+    CHECK(preciseFiredAt.valid() && preciseLateUs >= 0 && preciseLateUs <= kToleranceUs);
+
+    // 100 个定时器跨度 100ms，每批至少覆盖 50ms 窗口，批数应远小于定时器个数
+    LOG_INFO << kTimers << " slack timers fired in " << batches.size() << " batches";
+    CHECK(batches.size() <= 5);
+    return 0;
+}
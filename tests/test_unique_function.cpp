@@ -0,0 +1,176 @@
+// tests/test_unique_function.cpp
+// 验证 UniqueFunction，并用替换全局 operator new 的方式统计内存分配：
+// - 捕获一个 shared_ptr 加几个参数的 lambda / bind 放在内联缓冲里，不分配；同样的对象放进 std::function 要分配
+// - 超出内联缓冲的对象分配一次，之后移动只搬指针
+// - 只能移动的捕获、带参数和返回值、空的函数指针 / std::function 构造出空对象
+// - 稳定之后，从别的线程 queueInLoop 到 EventLoop、再由 loop 执行，整条路径不分配内存
+
+#include "base/UniqueFunction.h"
+#include "net/EventLoop.h"
+#include "net/EventLoopThread.h"
+#include "TestCheck.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+
+namespace
+{
+std::atomic<long> g_allocations(0);
+}
+
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+namespace
+{
+
+// 统计 fn 执行期间 (所有线程) 的分配次数
+template<typename Fn>
+long allocationsDuring(Fn&& fn)
+{
+    long before = g_allocations.load();
+    fn();
+    return g_allocations.load() - before;
+}
+
+struct Session
+{
+    void onMessage(int a, int b, int c) { sum += a + b + c; }
+    int sum = 0;
+};
+
+void testInline()
+{
+    auto session = std::make_shared<Session>();
+    int a = 1, b = 2, c = 3;
+    auto lambda = [session, a, b, c]() { session->onMessage(a, b, c); };
+    static_assert(sizeof(lambda) > 16, "should overflow std::function's small buffer");
+
+    long allocs = allocationsDuring([&]() {
+        UniqueFunction<void()> fn(lambda);
+        UniqueFunction<void()> moved(std::move(fn));
+        CHECK(!fn && moved);
+        moved();
+        UniqueFunction<void()> bound(std::bind(&Session::onMessage, session, a, b, c));
+        bound();
+    });
+    CHECK(allocs == 0);
+    CHECK(session->sum == 12);
+
+    allocs = allocationsDuring([&]() {
+        std::function<void()> fn(lambda);
+        fn();
+    });
+    CHECK(allocs > 0); // 对照：std::function 要分配
+}
+
+void testHeap()
+{
+    std::array<char, 128> big{};
+    big[0] = 7;
+    int result = 0;
+    long allocs = allocationsDuring([&]() {
+        UniqueFunction<void()> fn([big, &result]() { result = big[0]; });
+        UniqueFunction<void()> moved(std::move(fn));
+        moved();
+    });
+    CHECK(allocs == 1);
+    CHECK(result == 7);
+}
+
+void testSemantics()
+{
+    auto owned = std::make_unique<int>(5);
+    UniqueFunction<int(int)> add([p = std::move(owned)](int x) { return *p + x; });
+    CHECK(add(3) == 8);
+
+    UniqueFunction<int(int)> other;
+    CHECK(!other);
+    other = std::move(add);
+    CHECK(!add && other(1) == 6);
+    other = nullptr;
+    CHECK(!other);
+
+    void (*nullFn)() = nullptr;
+    UniqueFunction<void()> fromNull(nullFn);
+    CHECK(!fromNull);
+    UniqueFunction<void()> fromEmpty{std::function<void()>()};
+    CHECK(!fromEmpty);
+
+    // 销毁时释放捕获
+    auto shared = std::make_shared<int>(1);
+    {
+        UniqueFunction<void()> holder([shared]() {});
+        CHECK(shared.use_count() == 2);
+    }
+    CHECK(shared.use_count() == 1);
+}
+
+void testCrossThreadPost()
+{
+    EventLoopThread loopThread;
+    EventLoop* loop = loopThread.startLoop();
+
+    auto session = std::make_shared<Session>();
+    std::atomic<int> executed(0);
+    const int kBatch = 64;
+
+    auto postBatch = [&]() {
+        int target = executed.load() + kBatch;
+        for (int i = 0; i < kBatch; ++i)
+        {
+            // 典型的投递：一个 shared_ptr、几个参数、一个计数器指针
+            loop->queueInLoop([session, i, &executed]() {
+                session->onMessage(i, i, i);
+                executed.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        while (executed.load() < target)
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    // 预热：pending functor 的 vector 扩容到够用
+    for (int round = 0; round < 20; ++round)
+    {
+        postBatch();
+    }
+    long allocs = allocationsDuring([&]() {
+        for (int round = 0; round < 200; ++round)
+        {
+            postBatch();
+        }
+    });
+    printf("cross-thread post: %d functors, %ld allocations\n", 200 * kBatch, allocs);
+    CHECK(allocs == 0);
+    loop->quit();
+}
+
+} // namespace
+
+int main()
+{
+    testInline();
+    testHeap();
+    testSemantics();
+    testCrossThreadPost();
+    return 0;
+}
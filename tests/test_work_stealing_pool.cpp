@@ -0,0 +1,133 @@
+// tests/test_work_stealing_pool.cpp
+// 验证工作窃取线程池：
+// - ChaseLevDeque：所有者 push/take 的同时 3 个线程 steal，每个元素恰好被取走一次 (含扩容)
+// - 外部提交 100000 个任务，shutdown 返回时全部执行完
+// - 任务在 worker 中递归派生子任务，shutdown 返回时整棵树都执行完
+
+#include "base/WorkStealingPool.h"
+#include "base/ChaseLevDeque.h"
+#include "base/Logger.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+void testDeque()
+{
+    const int kItems = 200000;
+    const int kThieves = 3;
+    std::vector<int> values(kItems);
+    std::vector<std::atomic<int>> seen(kItems);
+    for (int i = 0; i < kItems; ++i)
+    {
+        values[i] = i;
+        seen[i] = 0;
+    }
+
+    ChaseLevDeque<int> deque(16); // 小初始容量，迫使扩容
+    std::atomic<int> consumed(0);
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; ++t)
+    {
+        thieves.emplace_back([&]() {
+            while (!done.load())
+            {
+                if (int* item = deque.steal())
+                {
+                    seen[*item]++;
+                    consumed++;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < kItems; ++i)
+    {
+        deque.push(&values[i]);
+        if (i % 3 == 0)
+        {
+            if (int* item = deque.take())
+            {
+                seen[*item]++;
+                consumed++;
+            }
+        }
+    }
+    while (int* item = deque.take())
+    {
+        seen[*item]++;
+        consumed++;
+    }
+    // take 返回空时可能还有窃取者拿到了元素但尚未计数
+    while (consumed.load() < kItems)
+    {
+        std::this_thread::yield();
+    }
+    done = true;
+    for (auto& thief : thieves)
+    {
+        thief.join();
+    }
+
+    assert(consumed.load() == kItems);
+    for (int i = 0; i < kItems; ++i)
+    {
+        assert(seen[i].load() == 1);
+    }
+}
+
+void testExternalTasks()
+{
+    WorkStealingPool pool(4, "StealPool");
+    pool.start();
+
+    const int kTasks = 100000;
+    std::atomic<int> completed(0);
+    for (int i = 0; i < kTasks; ++i)
+    {
+        pool.addTask([&completed]() { completed++; });
+    }
+    pool.shutdown();
+    assert(completed.load() == kTasks);
+}
+
+// 深度为 depth 的二叉树，每个节点一个任务
+void spawn(WorkStealingPool& pool, std::atomic<int>& completed, int depth)
+{
+    completed++;
+    if (depth == 0)
+    {
+        return;
+    }
+    pool.addTask([&pool, &completed, depth]() { spawn(pool, completed, depth - 1); });
+    pool.addTask([&pool, &completed, depth]() { spawn(pool, completed, depth - 1); });
+}
+
+void testRecursiveTasks()
+{
+    WorkStealingPool pool(4, "StealPool");
+    pool.start();
+
+    const int kDepth = 16;
+    std::atomic<int> completed(0);
+    pool.addTask([&pool, &completed]() { spawn(pool, completed, kDepth); });
+    // 让树先长出来，再在展开过程中关闭
+    while (completed.load() < 1000)
+    {
+        std::this_thread::yield();
+    }
+    pool.shutdown();
+    assert(completed.load() == (1 << (kDepth + 1)) - 1);
+}
+
+int main()
+{
+    testDeque();
+    testExternalTasks();
+    testRecursiveTasks();
+    LOG_INFO << "work stealing pool ok";
+    return 0;
+}
@@ -0,0 +1,47 @@
+// tools/binlog_decode.cpp
+// 把 BinaryLogger 写出的二进制日志还原成文本，格式与 LogStream 输出相同。
+// 用法: binlog_decode <file.binlog> [output.log]，默认输出到 stdout
+
+#include "base/BinaryLog.h"
+
+#include <cstdio>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <file.binlog> [output.log]\n", argv[0]);
+        return 2;
+    }
+
+    FILE* in = ::fopen(argv[1], "rb");
+    if (in == nullptr)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    FILE* out = stdout;
+    if (argc > 2)
+    {
+        out = ::fopen(argv[2], "w");
+        if (out == nullptr)
+        {
+            perror(argv[2]);
+            ::fclose(in);
+            return 1;
+        }
+    }
+
+    bool ok = binlog::decode(in, out);
+    ::fclose(in);
+    if (out != stdout)
+    {
+        ::fclose(out);
+    }
+    if (!ok)
+    {
+        fprintf(stderr, "%s: corrupted or truncated binary log\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}